@@ -10,6 +10,8 @@
 
 #include "CoreMinimal.h"
 
+#include <cmath>
+
 class FCubismMath
 {
 public:
@@ -29,4 +31,100 @@ public:
 
 		return Radian;
 	}
+
+	/**
+	 * The tolerance under which a coefficient of an equation is regarded as zero.
+	 */
+	static constexpr float Epsilon = 0.00001f;
+
+	/**
+	 * @brief The function to solve the quadratic equation a*x^2 + b*x + c = 0.
+	 * @return One of the solutions of the equation.
+	 */
+	static float QuadraticEquation(const float A, const float B, const float C)
+	{
+		if (FMath::Abs(A) < Epsilon)
+		{
+			if (FMath::Abs(B) < Epsilon)
+			{
+				return -C;
+			}
+
+			return -C / B;
+		}
+
+		return -(B + FMath::Sqrt(B * B - 4.0f * A * C)) / (2.0f * A);
+	}
+
+	/**
+	 * @brief The function to solve the cubic equation a*x^3 + b*x^2 + c*x + d = 0 with the Cardano's formula for the Bezier curves.
+	 * @return The solution of the equation in the range [0, 1] that is nearest to the center of the range.
+	 */
+	static float CardanoAlgorithmForBezier(const float A, const float B, const float C, const float D)
+	{
+		if (FMath::Abs(A) < Epsilon)
+		{
+			return FMath::Clamp(QuadraticEquation(B, C, D), 0.0f, 1.0f);
+		}
+
+		const float BA = B / A;
+		const float CA = C / A;
+		const float DA = D / A;
+
+		const float P = (3.0f * CA - BA * BA) / 3.0f;
+		const float P3 = P / 3.0f;
+		const float Q = (2.0f * BA * BA * BA - 9.0f * BA * CA + 27.0f * DA) / 27.0f;
+		const float Q2 = Q / 2.0f;
+		const float Discriminant = Q2 * Q2 + P3 * P3 * P3;
+
+		const float Center = 0.5f;
+		const float Threshold = Center + 0.01f;
+
+		if (Discriminant < 0.0f)
+		{
+			const float MP3 = -P / 3.0f;
+			const float MP33 = MP3 * MP3 * MP3;
+			const float R = FMath::Sqrt(MP33);
+			const float T = -Q / (2.0f * R);
+			const float CosPhi = FMath::Clamp(T, -1.0f, 1.0f);
+			const float Phi = FMath::Acos(CosPhi);
+			const float CrtR = cbrtf(R);
+			const float T1 = 2.0f * CrtR;
+
+			const float Root1 = T1 * FMath::Cos(Phi / 3.0f) - BA / 3.0f;
+			if (FMath::Abs(Root1 - Center) < Threshold)
+			{
+				return FMath::Clamp(Root1, 0.0f, 1.0f);
+			}
+
+			const float Root2 = T1 * FMath::Cos((Phi + 2.0f * PI) / 3.0f) - BA / 3.0f;
+			if (FMath::Abs(Root2 - Center) < Threshold)
+			{
+				return FMath::Clamp(Root2, 0.0f, 1.0f);
+			}
+
+			const float Root3 = T1 * FMath::Cos((Phi + 4.0f * PI) / 3.0f) - BA / 3.0f;
+			return FMath::Clamp(Root3, 0.0f, 1.0f);
+		}
+
+		if (Discriminant == 0.0f)
+		{
+			const float U1 = Q2 < 0.0f ? cbrtf(-Q2) : -cbrtf(Q2);
+
+			const float Root1 = 2.0f * U1 - BA / 3.0f;
+			if (FMath::Abs(Root1 - Center) < Threshold)
+			{
+				return FMath::Clamp(Root1, 0.0f, 1.0f);
+			}
+
+			const float Root2 = -U1 - BA / 3.0f;
+			return FMath::Clamp(Root2, 0.0f, 1.0f);
+		}
+
+		const float SD = FMath::Sqrt(Discriminant);
+		const float U1 = cbrtf(SD - Q2);
+		const float V1 = cbrtf(SD + Q2);
+		const float Root1 = U1 - V1 - BA / 3.0f;
+		return FMath::Clamp(Root1, 0.0f, 1.0f);
+	}
 };
@@ -0,0 +1,26 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("Cubism"), STATGROUP_Cubism, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Motion Update"), STAT_CubismMotionUpdate, STATGROUP_Cubism, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Motion Curve Evaluation"), STAT_CubismMotionEvaluation, STATGROUP_Cubism, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Expression Update"), STAT_CubismExpressionUpdate, STATGROUP_Cubism, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Physics Update"), STAT_CubismPhysicsUpdate, STATGROUP_Cubism, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Model Update"), STAT_CubismModelUpdate, STATGROUP_Cubism, );
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Motion Components"), STAT_CubismMotionComponents, STATGROUP_Cubism, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Queued Motions"), STAT_CubismQueuedMotions, STATGROUP_Cubism, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Motions"), STAT_CubismActiveMotions, STATGROUP_Cubism, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Curves Evaluated"), STAT_CubismCurvesEvaluated, STATGROUP_Cubism, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Parameter Lookups"), STAT_CubismParameterLookups, STATGROUP_Cubism, );
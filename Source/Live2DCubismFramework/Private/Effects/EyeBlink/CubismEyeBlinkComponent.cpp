@@ -40,12 +40,24 @@ void UCubismEyeBlinkComponent::Setup(UCubismModelComponent* InModel)
 		Ids.Append(Json->EyeBlinks);
 	}
 
+	Model->GetParameterIndices(Ids, Model->EyeBlinkParameterIndices);
+
 	AddTickPrerequisiteComponent(Model->ParameterStore); // must be updated after parameters loaded
 	AddTickPrerequisiteComponent(Model->Motion); // must be updated at first because motions overwrite parameters
 	AddTickPrerequisiteComponent(Model->Pose); // must be updated at first because poses overwrite parameters
 	Model->AddTickPrerequisiteComponent(this); // must update parameters on memory after parameter updated
 }
 
+void UCubismEyeBlinkComponent::SetIds(const TArray<FString>& InIds)
+{
+	Ids = InIds;
+
+	if (Model)
+	{
+		Model->GetParameterIndices(Ids, Model->EyeBlinkParameterIndices);
+	}
+}
+
 // UObject interface
 void UCubismEyeBlinkComponent::PostLoad()
 {
@@ -65,9 +77,9 @@ void UCubismEyeBlinkComponent::PostEditChangeProperty(FPropertyChangedEvent& Pro
 
 	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismEyeBlinkComponent, Value))
 	{
-		for (const FString& Id : Ids)
+		for (const int32 ParameterIndex : Model->EyeBlinkParameterIndices)
 		{
-			UCubismParameterComponent* Destination = Model->GetParameter(Id);
+			UCubismParameterComponent* Destination = Model->GetParameter(ParameterIndex);
 
 			if (!Destination)
 			{
@@ -99,6 +111,11 @@ void UCubismEyeBlinkComponent::PostEditChangeProperty(FPropertyChangedEvent& Pro
 			}
 		}
 	}
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismEyeBlinkComponent, Ids))
+	{
+		Model->GetParameterIndices(Ids, Model->EyeBlinkParameterIndices);
+	}
+
 	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismEyeBlinkComponent, bAutoEnabled))
 	{
 		Time = 0.0f;
@@ -117,15 +134,26 @@ void UCubismEyeBlinkComponent::OnComponentCreated()
 	Setup(Owner->Model);
 }
 
+void UCubismEyeBlinkComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
+{
+	// the motions stop modulating the eye blink parameters without the component
+	if (Model)
+	{
+		Model->EyeBlinkParameterIndices.Empty();
+	}
+
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
 void UCubismEyeBlinkComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	Update(DeltaTime);
 
-	for (const FString& Id : Ids)
+	for (const int32 ParameterIndex : Model->EyeBlinkParameterIndices)
 	{
-		UCubismParameterComponent* Destination = Model->GetParameter(Id);
+		UCubismParameterComponent* Destination = Model->GetParameter(ParameterIndex);
 
 		if (!Destination)
 		{
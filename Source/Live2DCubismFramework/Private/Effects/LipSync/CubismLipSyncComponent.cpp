@@ -49,6 +49,8 @@ void UCubismLipSyncComponent::Setup(UCubismModelComponent* InModel)
 		Ids.Append(Json->LipSyncs);
 	}
 
+	Model->GetParameterIndices(Ids, Model->LipSyncParameterIndices);
+
 	if (!Audio)
 	{
 		Audio = CreateAudioComponent();
@@ -113,6 +115,16 @@ TObjectPtr<UAudioComponent> UCubismLipSyncComponent::CreateAudioComponent()
 	return NewAudio;
 }
 
+void UCubismLipSyncComponent::SetIds(const TArray<FString>& InIds)
+{
+	Ids = InIds;
+
+	if (Model)
+	{
+		Model->GetParameterIndices(Ids, Model->LipSyncParameterIndices);
+	}
+}
+
 // UObject interface
 void UCubismLipSyncComponent::PostLoad()
 {
@@ -132,9 +144,9 @@ void UCubismLipSyncComponent::PostEditChangeProperty(FPropertyChangedEvent& Prop
 
 	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismLipSyncComponent, Value))
 	{
-		for (const FString& Id : Ids)
+		for (const int32 ParameterIndex : Model->LipSyncParameterIndices)
 		{
-			UCubismParameterComponent* Destination = Model->GetParameter(Id);
+			UCubismParameterComponent* Destination = Model->GetParameter(ParameterIndex);
 
 			if (!Destination)
 			{
@@ -167,6 +179,11 @@ void UCubismLipSyncComponent::PostEditChangeProperty(FPropertyChangedEvent& Prop
 		}
 	}
 
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismLipSyncComponent, Ids))
+	{
+		Model->GetParameterIndices(Ids, Model->LipSyncParameterIndices);
+	}
+
 	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismLipSyncComponent, bAutoEnabled))
 	{
 		Time = 0.0f;
@@ -213,6 +230,12 @@ void UCubismLipSyncComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 		Audio = nullptr;
 	}
 
+	// the motions stop modulating the lip sync parameters without the component
+	if (Model)
+	{
+		Model->LipSyncParameterIndices.Empty();
+	}
+
 	Super::OnComponentDestroyed(bDestroyingHierarchy);
 }
 
@@ -222,9 +245,9 @@ void UCubismLipSyncComponent::TickComponent(float DeltaTime, ELevelTick TickType
 
 	Update(DeltaTime);
 
-	for (const FString& Id : Ids)
+	for (const int32 ParameterIndex : Model->LipSyncParameterIndices)
 	{
-		UCubismParameterComponent* Destination = Model->GetParameter(Id);
+		UCubismParameterComponent* Destination = Model->GetParameter(ParameterIndex);
 
 		if (!Destination)
 		{
@@ -14,6 +14,7 @@
 #include "Model/CubismModelActor.h"
 #include "Model/CubismModelComponent.h"
 #include "CubismLog.h"
+#include "CubismStats.h"
 
 UCubismExpressionComponent::UCubismExpressionComponent()
 {
@@ -122,6 +123,8 @@ void UCubismExpressionComponent::TickComponent(float DeltaTime, ELevelTick TickT
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	SCOPE_CYCLE_COUNTER(STAT_CubismExpressionUpdate);
+
 	Time += DeltaTime;
 
 	float ExpressionWeight = 0.0f;
@@ -8,12 +8,28 @@
 
 #include "Live2DCubismFrameworkModule.h"
 #include "CubismLog.h"
+#include "CubismStats.h"
+#include "Rendering/CubismMaterialPermutation.h"
+#include "Engine/Engine.h"
 #include "Interfaces/IPluginManager.h"
+#include "Misc/CoreDelegates.h"
 
 #define LOCTEXT_NAMESPACE "FLive2DCubismFrameworkModule"
 
 DEFINE_LOG_CATEGORY(LogCubism)
 
+DEFINE_STAT(STAT_CubismMotionUpdate);
+DEFINE_STAT(STAT_CubismMotionEvaluation);
+DEFINE_STAT(STAT_CubismExpressionUpdate);
+DEFINE_STAT(STAT_CubismPhysicsUpdate);
+DEFINE_STAT(STAT_CubismModelUpdate);
+
+DEFINE_STAT(STAT_CubismMotionComponents);
+DEFINE_STAT(STAT_CubismQueuedMotions);
+DEFINE_STAT(STAT_CubismActiveMotions);
+DEFINE_STAT(STAT_CubismCurvesEvaluated);
+DEFINE_STAT(STAT_CubismParameterLookups);
+
 void FLive2DCubismFrameworkModule::StartupModule()
 {
 	const FString PluginShaderDir = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("Live2DCubismSDK"))->GetBaseDir(), TEXT("Shaders"));
@@ -35,6 +51,20 @@ void FLive2DCubismFrameworkModule::StartupModule()
 
 	UE_LOG(LogCubism, Log, TEXT("Live2D Cubism Core version: %02d.%02d.%04d (%d)"), Major, Minor, Patch, VersionNumber);
 
+	// warm up the materials of the drawables so that the first model on screen does not hitch
+	if (!IsRunningCommandlet())
+	{
+		// the module loaded or reloaded after the engine init misses the delegate
+		if (GEngine && GIsRunning)
+		{
+			FCubismMaterialPrecache::PrecacheAll();
+		}
+		else
+		{
+			PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&FCubismMaterialPrecache::PrecacheAll);
+		}
+	}
+
 	UE_LOG(LogCubism, Log, TEXT("FLive2DCubismFrameworkModule::StartupModule() is complete."));
 
 	bIsModuleStarted = true;
@@ -51,6 +81,10 @@ void FLive2DCubismFrameworkModule::ShutdownModule()
 		return;
 	}
 
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+
+	FCubismMaterialPrecache::Release();
+
 	bIsModuleStarted = false;
 
 	UE_LOG(LogCubism, Log, TEXT("FLive2DCubismFrameworkModule::ShutdownModule() is complete."));
@@ -11,10 +11,16 @@
 #include "Model/CubismModelActor.h"
 #include "Model/CubismModelComponent.h"
 #include "Rendering/CubismDrawableSceneProxy.h"
+#include "Rendering/CubismMaterialPermutation.h"
+#include "Rendering/CubismModelMeshComponent.h"
 #include "CubismLog.h"
 #include "Live2DCubismCore.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Math/Vector.h"
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+#include "LocalVertexFactory.h"
+#include "PSOPrecache.h"
+#endif
 
 UCubismDrawableComponent::UCubismDrawableComponent()
 {
@@ -22,6 +28,9 @@ UCubismDrawableComponent::UCubismDrawableComponent()
 	PrimaryComponentTick.TickGroup = TG_DuringPhysics;
 	bTickInEditor = true;
 	bBoundsDirty = true;
+	bDynamicVisible = true;
+	bLastRenderable = true;
+	bTopologyDirty = true;
 }
 
 void UCubismDrawableComponent::Setup(UCubismModelComponent* InModel)
@@ -84,6 +93,8 @@ void UCubismDrawableComponent::Setup(UCubismModelComponent* InModel)
 	}
 
 	Opacity = Model->GetDrawableOpacity(Index);
+	bDynamicVisible = Model->GetDrawableDynamicFlagIsVisible(Index);
+	bLastRenderable = IsRenderable();
 	BaseColor = FLinearColor::White;
 	MultiplyColor = Model->GetDrawableMultiplyColor(Index);
 	ScreenColor = Model->GetDrawableScreenColor(Index);
@@ -100,33 +111,14 @@ void UCubismDrawableComponent::Setup(UCubismModelComponent* InModel)
 	BlendMode = Model->GetDrawableBlendMode(Index);
 	InvertedMask = Model->GetDrawableInvertedMask(Index);
 
-	FString MaterialName;
+	FCubismMaterialPermutation Permutation;
+	Permutation.BlendMode = BlendMode;
+	Permutation.bMasked = IsMasked();
+	Permutation.bInvertedMask = InvertedMask;
 
-	switch(BlendMode)
-	{
-		case ECubismDrawableBlendMode::Normal:
-		{
-			MaterialName = !IsMasked()? TEXT("CustomUnlitNormal") : InvertedMask? TEXT("CustomUnlitNormalMaskedInverted") : TEXT("CustomUnlitNormalMasked");
-			break;
-		}
-		case ECubismDrawableBlendMode::Additive:
-		{
-			MaterialName = !IsMasked()? TEXT("CustomUnlitAdditive") : InvertedMask? TEXT("CustomUnlitAdditiveMaskedInverted") : TEXT("CustomUnlitAdditiveMasked");
-			break;
-		}
-		case ECubismDrawableBlendMode::Multiplicative:
-		{
-			MaterialName = !IsMasked()? TEXT("CustomUnlitMultiplicative") : InvertedMask? TEXT("CustomUnlitMultiplicativeMaskedInverted") : TEXT("CustomUnlitMultiplicativeMasked");
-			break;
-		}
-		default:
-		{
-			ensure(false);
-			break;
-		}
-	}
+	const FString MaterialName = Permutation.GetMaterialName();
 
-	UMaterial* Material = Cast<UMaterial>(StaticLoadObject(UMaterial::StaticClass(), nullptr, *(TEXT("/Live2DCubismSDK/Materials") / MaterialName)));
+	UMaterialInterface* Material = Permutation.LoadMaterial();
 	UMaterialInstanceDynamic* MaterialInstance = UMaterialInstanceDynamic::Create(Material, this, *MaterialName);
 
 	SetMaterial(0, static_cast<UMaterialInterface*>(MaterialInstance));
@@ -168,6 +160,69 @@ int32 UCubismDrawableComponent::GetDrawableMaskCount() const
 	return Model->GetDrawableMaskCount(Index);
 }
 
+bool UCubismDrawableComponent::IsRenderable() const
+{
+	if (!bDynamicVisible)
+	{
+		return false;
+	}
+
+	return Opacity * (Model? Model->Opacity : 1.0f) > 0.0f;
+}
+
+void UCubismDrawableComponent::SetModelMesh(UCubismModelMeshComponent* InModelMesh)
+{
+	if (ModelMesh == InModelMesh)
+	{
+		return;
+	}
+
+	ModelMesh = InModelMesh;
+
+	// recreate the proxy, the drawable has no proxy while the model mesh renders it
+	MarkRenderStateDirty();
+}
+
+void UCubismDrawableComponent::GetDynamicMeshData(FCubismDrawableDynamicMeshData& OutDynamicData, const bool bVertexPositions, const bool bTopology) const
+{
+	OutDynamicData.Index = Index;
+	OutDynamicData.RenderOrder = RenderOrder;
+	OutDynamicData.bVisible = IsRenderable();
+
+	OutDynamicData.Color = BaseColor.ToRGBE();
+	OutDynamicData.Color.A *= Opacity;
+
+	OutDynamicData.bTwoSided = bTwoSided;
+
+	// the indices and the UVs never change, so they are only sent to the new proxy
+	if (bTopology)
+	{
+		OutDynamicData.Indices.Reserve(VertexIndices.Num());
+		for (const int32 VertexIndex : VertexIndices)
+		{
+			OutDynamicData.Indices.Add(static_cast<uint32>(VertexIndex));
+		}
+
+		OutDynamicData.UVs.Reserve(VertexUvs.Num());
+		for (const FVector2D& Uv : VertexUvs)
+		{
+			OutDynamicData.UVs.Add(FVector2f(Uv));
+		}
+	}
+
+	// the rendering thread needs no vertices of the invisible drawable except to create its buffers
+	if (!bTopology && !(bVertexPositions && OutDynamicData.bVisible))
+	{
+		return;
+	}
+
+	OutDynamicData.Positions.Reserve(VertexPositions.Num());
+	for (const FVector2D& LocalPosition : VertexPositions)
+	{
+		OutDynamicData.Positions.Add(FVector3f(ToGlobalPosition(LocalPosition)));
+	}
+}
+
 // UObject interface
 void UCubismDrawableComponent::PostLoad()
 {
@@ -255,6 +310,26 @@ void UCubismDrawableComponent::OnComponentCreated()
 	Setup(Owner->Model);
 }
 
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+void UCubismDrawableComponent::CollectPSOPrecacheData(const FPSOPrecacheParams& BasePrecachePSOParams, FMaterialInterfacePSOPrecacheParamsList& OutParams)
+{
+	FMaterialInterfacePSOPrecacheParams& ComponentParams = OutParams[OutParams.AddDefaulted()];
+	ComponentParams.MaterialInterface = GetMaterial(0);
+	ComponentParams.VertexFactoryDataList.Add(FPSOPrecacheVertexFactoryData(&FLocalVertexFactory::StaticType));
+	ComponentParams.PSOPrecacheParams = BasePrecachePSOParams;
+}
+#endif
+
+void UCubismDrawableComponent::CreateRenderState_Concurrent(FRegisterComponentContext* Context)
+{
+	Super::CreateRenderState_Concurrent(Context);
+
+	// the new proxy needs the current vertices even if they do not change
+	bTopologyDirty = true;
+
+	SendRenderDynamicData_Concurrent();
+}
+
 void UCubismDrawableComponent::SendRenderDynamicData_Concurrent()
 {
 	Super::SendRenderDynamicData_Concurrent();
@@ -263,28 +338,14 @@ void UCubismDrawableComponent::SendRenderDynamicData_Concurrent()
 	{
 		FCubismDrawableDynamicMeshData NewDynamicData;
 
-		NewDynamicData.Index = Index;
-		NewDynamicData.Indices.Append(VertexIndices);
-
-		for (const FVector2D& LocalPosition : GetVertexPositions())
-		{
-			NewDynamicData.Positions.Add(FVector3f(ToGlobalPosition(LocalPosition)));
-		}
-
-		for (const FVector2D& Uv : GetVertexUvs())
-		{
-			NewDynamicData.UVs.Add(FVector2f(Uv));
-		}
-
-		NewDynamicData.Color = BaseColor.ToRGBE();
-		NewDynamicData.Color.A *= Opacity;
+		GetDynamicMeshData(NewDynamicData, true, bTopologyDirty);
 
-		NewDynamicData.bTwoSided = bTwoSided;
+		bTopologyDirty = false;
 
 		ENQUEUE_RENDER_COMMAND(DrawableUpdateDynamicData)(
-			[DrawableProxy, NewDynamicData](FRHICommandListImmediate& RHICommandList)
+			[DrawableProxy, NewDynamicData = MoveTemp(NewDynamicData)](FRHICommandListImmediate& RHICommandList) mutable
 			{
-				DrawableProxy->DynamicData = NewDynamicData;
+				DrawableProxy->SetDynamicData_RenderThread(RHICommandList, MoveTemp(NewDynamicData));
 			}
 		);
 	}
@@ -299,6 +360,26 @@ void UCubismDrawableComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 		Opacity = Model->GetDrawableOpacity(Index);
 	}
 
+	if (Model->GetDrawableDynamicFlagVisibilityDidChange(Index))
+	{
+		bDynamicVisible = Model->GetDrawableDynamicFlagIsVisible(Index);
+	}
+
+	// the vertex positions are still updated for masks while the drawable is invisible
+	const bool bRenderable = IsRenderable();
+
+	if (bRenderable != bLastRenderable)
+	{
+		bLastRenderable = bRenderable;
+
+		MarkRenderDynamicDataDirty();
+
+		if (ModelMesh)
+		{
+			ModelMesh->MarkDrawableDirty(Index, true);
+		}
+	}
+
 	if (Model->GetDrawableDynamicFlagVertexPositionsDidChange(Index))
 	{
 		VertexPositions.Empty();
@@ -313,7 +394,27 @@ void UCubismDrawableComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 		}
 
 		bBoundsDirty = true;
-		MarkRenderDynamicDataDirty();
+
+		// no dynamic data is sent while the drawable is invisible
+		if (bRenderable)
+		{
+			MarkRenderDynamicDataDirty();
+
+			if (ModelMesh)
+			{
+				ModelMesh->MarkDrawableDirty(Index, true);
+			}
+		}
+	}
+
+	if (Model->GetDrawableDynamicFlagRenderOrderDidChange(Index))
+	{
+		RenderOrder = Model->GetDrawableRenderOrder(Index);
+
+		if (ModelMesh)
+		{
+			ModelMesh->MarkDrawableDirty(Index, false);
+		}
 	}
 
 	if (Model->GetDrawableDynamicFlagBlendColorDidChange(Index))
@@ -352,11 +453,27 @@ FBoxSphereBounds UCubismDrawableComponent::CalcBounds(const FTransform& LocalToW
 
 	return LocalBounds.TransformBy(LocalToWorld);
 }
+
+void UCubismDrawableComponent::OnVisibilityChanged()
+{
+	Super::OnVisibilityChanged();
+
+	// the model mesh has no vertices of the hidden drawable
+	if (ModelMesh)
+	{
+		ModelMesh->MarkDrawableDirty(Index, true);
+	}
+}
 //~ End USceneComponent Interface
 
 //~ Begin UPrimitiveComponent Interface
 FPrimitiveSceneProxy* UCubismDrawableComponent::CreateSceneProxy()
 {
+	if (ModelMesh)
+	{
+		return nullptr;
+	}
+
 	return new FCubismDrawableSceneProxy(this);
 }
 //~ End UPrimitiveComponent Interface
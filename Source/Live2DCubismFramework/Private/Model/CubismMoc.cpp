@@ -103,6 +103,74 @@ int32 UCubismMoc3::GetSizeOfModel() const
 	return csmGetSizeofModel(RawMoc);
 }
 
+TArray<FCubismMaterialPermutation> UCubismMoc3::GetMaterialPermutations() const
+{
+	TArray<FCubismMaterialPermutation> Permutations;
+
+	if (!RawMoc)
+	{
+		return Permutations;
+	}
+
+	// a temporary model is enough to read the constant flags of the drawables
+	const uint32 Size = csmGetSizeofModel(RawMoc);
+
+	void* ModelAddress = FMemory::Malloc(Size, csmAlignofModel);
+
+	csmModel* RawModel = csmInitializeModelInPlace(RawMoc, ModelAddress, Size);
+
+	const int32 DrawableCount = csmGetDrawableCount(RawModel);
+	const csmFlags* ConstantFlags = csmGetDrawableConstantFlags(RawModel);
+	const int32* MaskCounts = csmGetDrawableMaskCounts(RawModel);
+
+	for (int32 DrawableIndex = 0; DrawableIndex < DrawableCount; DrawableIndex++)
+	{
+		FCubismMaterialPermutation Permutation;
+
+		if ((ConstantFlags[DrawableIndex] & csmBlendAdditive) == csmBlendAdditive)
+		{
+			Permutation.BlendMode = ECubismDrawableBlendMode::Additive;
+		}
+		else if ((ConstantFlags[DrawableIndex] & csmBlendMultiplicative) == csmBlendMultiplicative)
+		{
+			Permutation.BlendMode = ECubismDrawableBlendMode::Multiplicative;
+		}
+		else
+		{
+			Permutation.BlendMode = ECubismDrawableBlendMode::Normal;
+		}
+
+		Permutation.bMasked = MaskCounts[DrawableIndex] > 0;
+		Permutation.bInvertedMask = Permutation.bMasked && (ConstantFlags[DrawableIndex] & csmIsInvertedMask) == csmIsInvertedMask;
+
+		if (FCubismMaterialPermutation* Found = Permutations.FindByKey(Permutation))
+		{
+			Found->NumDrawables++;
+		}
+		else
+		{
+			Permutation.NumDrawables = 1;
+			Permutations.Add(Permutation);
+		}
+	}
+
+	FMemory::Free(ModelAddress);
+
+	return Permutations;
+}
+
+void UCubismMoc3::LogMaterialPermutations() const
+{
+	const TArray<FCubismMaterialPermutation> Permutations = GetMaterialPermutations();
+
+	UE_LOG(LogCubism, Log, TEXT("%s needs %d of %d material permutations."), *GetName(), Permutations.Num(), FCubismMaterialPermutation::GetAll().Num());
+
+	for (const FCubismMaterialPermutation& Permutation : Permutations)
+	{
+		UE_LOG(LogCubism, Log, TEXT("  %s: %d drawables"), *Permutation.GetMaterialName(), Permutation.NumDrawables);
+	}
+}
+
 void UCubismMoc3::PostLoad()
 {
 	Super::PostLoad();
@@ -15,6 +15,7 @@
 #include "Model/CubismPartComponent.h"
 #include "Rendering/CubismRendererComponent.h"
 #include "CubismLog.h"
+#include "CubismStats.h"
 
 UCubismModelComponent::UCubismModelComponent()
 {
@@ -43,6 +44,9 @@ void UCubismModelComponent::Setup()
 		Parameter->Setup(this);
 	}
 
+	StagedParameterValues.SetNumZeroed(Parameters.Num());
+	StagedParameterFlags.Init(false, Parameters.Num());
+
 	for (const TObjectPtr<UCubismPartComponent>& Part : Parts)
 	{
 		Part->Setup(this);
@@ -51,6 +55,22 @@ void UCubismModelComponent::Setup()
 	AddTickPrerequisiteComponent(ParameterStore); // must be updated after parameters loaded
 }
 
+void UCubismModelComponent::UpdateModel()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CubismModelUpdate);
+
+	CommitParameterValues();
+
+	if (RawModel)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(csmUpdateModel);
+
+		csmUpdateModel(RawModel);
+
+		csmResetDrawableDynamicFlags(RawModel);
+	}
+}
+
 ////
 
 FVector2D UCubismModelComponent::GetCanvasSize() const
@@ -142,6 +162,8 @@ FString UCubismModelComponent::GetParameterId(const int32 ParameterIndex) const
 
 int32 UCubismModelComponent::GetParameterIndex(const FString ParameterId)
 {
+	INC_DWORD_STAT(STAT_CubismParameterLookups);
+
 	if (ParameterId.IsEmpty())
 	{
 		return -1;
@@ -167,6 +189,21 @@ UCubismParameterComponent* UCubismModelComponent::GetParameter(const FString Par
 	return GetParameter(ParameterIndex);
 }
 
+void UCubismModelComponent::GetParameterIndices(const TArray<FString>& ParameterIds, TArray<int32>& OutParameterIndices)
+{
+	OutParameterIndices.Reset(ParameterIds.Num());
+
+	for (const FString& ParameterId : ParameterIds)
+	{
+		const int32 ParameterIndex = GetParameterIndex(ParameterId);
+
+		if (ParameterIndex != INDEX_NONE)
+		{
+			OutParameterIndices.Add(ParameterIndex);
+		}
+	}
+}
+
 ////
 
 int32 UCubismModelComponent::GetPartCount() const
@@ -259,6 +296,11 @@ float UCubismModelComponent::GetParameterDefaultValue(const int32 ParameterIndex
 
 float UCubismModelComponent::GetParameterValue(const int32 ParameterIndex) const
 {
+	if (StagedParameterFlags.IsValidIndex(ParameterIndex) && StagedParameterFlags[ParameterIndex])
+	{
+		return StagedParameterValues[ParameterIndex];
+	}
+
 	if (NonNativeParameterValues.Contains(ParameterIndex))
 	{
 		return NonNativeParameterValues[ParameterIndex];
@@ -271,15 +313,46 @@ float UCubismModelComponent::GetParameterValue(const int32 ParameterIndex) const
 
 void UCubismModelComponent::SetParameterValue(const int32 ParameterIndex, const float Value)
 {
-	if (NonNativeParameterValues.Contains(ParameterIndex))
+	check((0 <= ParameterIndex && ParameterIndex < GetParameterCount()) || NonNativeParameterValues.Contains(ParameterIndex));
+
+	if (StagedParameterFlags.Num() <= ParameterIndex)
 	{
-		NonNativeParameterValues[ParameterIndex] = Value;
-		return;
+		// The parameters added after the setup.
+		StagedParameterValues.SetNumZeroed(ParameterIndex + 1);
+		StagedParameterFlags.Add(false, ParameterIndex + 1 - StagedParameterFlags.Num());
 	}
 
-	check(0 <= ParameterIndex && ParameterIndex < GetParameterCount());
+	StagedParameterValues[ParameterIndex] = Value;
+	StagedParameterFlags[ParameterIndex] = true;
+}
+
+void UCubismModelComponent::CommitParameterValues()
+{
+	float* ParameterValues = RawModel? csmGetParameterValues(RawModel) : nullptr;
+
+	for (TConstSetBitIterator<> It(StagedParameterFlags); It; ++It)
+	{
+		const int32 ParameterIndex = It.GetIndex();
+		const UCubismParameterComponent* Parameter = GetParameter(ParameterIndex);
+
+		float Value = StagedParameterValues[ParameterIndex];
+
+		if (Parameter && !FGenericPlatformMath::IsNaN(Parameter->MinimumValue) && !FGenericPlatformMath::IsNaN(Parameter->MaximumValue))
+		{
+			Value = FMath::Clamp(Value, Parameter->MinimumValue, Parameter->MaximumValue);
+		}
 
-	csmGetParameterValues(RawModel)[ParameterIndex] = Value;
+		if (NonNativeParameterValues.Contains(ParameterIndex))
+		{
+			NonNativeParameterValues[ParameterIndex] = Value;
+		}
+		else if (ParameterValues)
+		{
+			ParameterValues[ParameterIndex] = Value;
+		}
+	}
+
+	StagedParameterFlags.Init(false, StagedParameterFlags.Num());
 }
 
 int32 UCubismModelComponent::GetParameterKeyCount(const int32 ParameterIndex) const
@@ -618,6 +691,9 @@ void UCubismModelComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 	Parameters.Empty();
 	Parts.Empty();
 
+	StagedParameterValues.Empty();
+	StagedParameterFlags.Empty();
+
 	DrawableIndices.Empty();
 	ParameterIndices.Empty();
 	PartIndices.Empty();
@@ -631,11 +707,6 @@ void UCubismModelComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (RawModel)
-	{
-		csmUpdateModel(RawModel);
-
-		csmResetDrawableDynamicFlags(RawModel);
-	}
+	UpdateModel();
 }
 // End of UActorComponent interface
@@ -64,42 +64,29 @@ float UCubismParameterComponent::GetParameterValue() const
 
 void UCubismParameterComponent::SetParameterValue(float TargetValue, const float Weight)
 {
-	if (!FGenericPlatformMath::IsNaN(MinimumValue) && !FGenericPlatformMath::IsNaN(MaximumValue))
-	{
-		TargetValue = FMath::Clamp(TargetValue, MinimumValue, MaximumValue);
-	}
-
-	float CurrentValue = Weight == 1.0f? TargetValue : Model->GetParameterValue(Index) * (1.0f - Weight) + TargetValue * Weight;
-
-	Value = (CurrentValue - MinimumValue) / (MaximumValue - MinimumValue);
+	const float CurrentValue = Weight == 1.0f? TargetValue : Model->GetParameterValue(Index) * (1.0f - Weight) + TargetValue * Weight;
 
-	Model->SetParameterValue(Index, CurrentValue);
+	StageParameterValue(CurrentValue);
 }
 
 void UCubismParameterComponent::AddParameterValue(float TargetValue, const float Weight)
 {
-	float CurrentValue = Model->GetParameterValue(Index) + TargetValue * Weight;
-
-	if (!FGenericPlatformMath::IsNaN(MinimumValue) && !FGenericPlatformMath::IsNaN(MaximumValue))
-	{
-		CurrentValue = FMath::Clamp(CurrentValue, MinimumValue, MaximumValue);
-	}
-
-	Value = (CurrentValue - MinimumValue) / (MaximumValue - MinimumValue);
+	const float CurrentValue = Model->GetParameterValue(Index) + TargetValue * Weight;
 
-	Model->SetParameterValue(Index, CurrentValue);
+	StageParameterValue(CurrentValue);
 }
 
 void UCubismParameterComponent::MultiplyParameterValue(float TargetValue, const float Weight)
 {
-	float CurrentValue = Model->GetParameterValue(Index) * (1.0f + (TargetValue - 1.0f) * Weight);
+	const float CurrentValue = Model->GetParameterValue(Index) * (1.0f + (TargetValue - 1.0f) * Weight);
 
-	if (!FGenericPlatformMath::IsNaN(MinimumValue) && !FGenericPlatformMath::IsNaN(MaximumValue))
-	{
-		CurrentValue = FMath::Clamp(CurrentValue, MinimumValue, MaximumValue);
-	}
+	StageParameterValue(CurrentValue);
+}
 
-	Value = (CurrentValue - MinimumValue) / (MaximumValue - MinimumValue);
+void UCubismParameterComponent::StageParameterValue(const float CurrentValue)
+{
+	// The value written to the model is clamped once when the model is updated, while the normalized value is kept up to date for the components reading it in between.
+	Value = (FMath::Clamp(CurrentValue, MinimumValue, MaximumValue) - MinimumValue) / (MaximumValue - MinimumValue);
 
 	Model->SetParameterValue(Index, CurrentValue);
 }
@@ -8,23 +8,77 @@
 
 #include "Motion/CubismMotion.h"
 
+#include "Model/CubismModelComponent.h"
+
+namespace
+{
+	/**
+	 * @brief The function to fill an array with a value, keeping its allocation if it is large enough.
+	 * @param Array The array to fill.
+	 * @param Value The value to fill with.
+	 * @param Num The number of the elements.
+	 */
+	template <typename ElementType>
+	void FillArray(TArray<ElementType>& Array, const ElementType Value, const int32 Num)
+	{
+		// TArray::Init resizes the allocation to the exact number
+		Array.Reset(Num);
+
+		for (int32 i = 0; i < Num; i++)
+		{
+			Array.Add(Value);
+		}
+	}
+}
+
 FCubismMotion::FCubismMotion(const UCubismMotion3Json* Json, const float InOffsetTime)
-	: Weight(1.0f)
-	, FadeOutSeconds(0.0f)
-	, EndTimeSeconds(-1.0f)
-	, bIsTriggeredFadeOut(false)
-	, bFinished(false)
 {
+	Reset(Json, InOffsetTime);
+}
+
+void FCubismMotion::Reset(const UCubismMotion3Json* Json, const float InOffsetTime)
+{
+	check(Json);
+
 	Duration = Json->Duration;
 	bLoop = Json->bLoop;
 	Fps = Json->Fps;
 	FadeInTime = Json->FadeInTime;
 	FadeOutTime = Json->FadeOutTime;
-	Curves = Json->Curves;
-	CurveTable = Json->CurveTable;
-	Events = Json->Events;
+	Data = Json->GetMotionData();
+	FillArray(SegmentCursors, (int32)INDEX_NONE, Data->Curves.Num());
+	FillArray(CurveValues, 0.0f, Data->Curves.Num());
+	LastEventTime = -1.0f;
+	EventCursor = 0;
 
+	StartTime = 0.0f;
 	OffsetTime = InOffsetTime;
+	EndTime = 0.0f;
+
+	State = ECubismMotionState::None;
+	Weight = 1.0f;
+	FadeOutSeconds = 0.0f;
+	EndTimeSeconds = -1.0f;
+	bIsTriggeredFadeOut = false;
+	bFinished = false;
+}
+
+void FCubismMotion::Bind(UCubismModelComponent* Model)
+{
+	check(Model);
+
+	FillArray(ParameterIndices, (int32)INDEX_NONE, Data->Curves.Num());
+
+	for (const int32 CurveIndex : Data->ParameterCurveIndices)
+	{
+		ParameterIndices[CurveIndex] = Model->GetParameterIndex(Data->Curves[CurveIndex].Id);
+	}
+
+	// the opacities of the parts are passed through the parameters with the IDs of the parts
+	for (const int32 CurveIndex : Data->PartOpacityCurveIndices)
+	{
+		ParameterIndices[CurveIndex] = Model->GetParameterIndex(Data->Curves[CurveIndex].Id);
+	}
 }
 
 void FCubismMotion::Init(const float Time)
@@ -0,0 +1,212 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Motion/CubismMotion3Json.h"
+
+#include "Motion/CubismMotionData.h"
+#include "Motion/CubismMotionCompression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "CubismLog.h"
+
+namespace
+{
+	/**
+	 * The version of the layout of the segments packed in the bulk data.
+	 */
+	constexpr int32 CubismSegmentBulkDataVersion = 2;
+}
+
+ECubismMotionModelCurve FCubismMotionCurve::ClassifyModelCurve(const FString& Id)
+{
+	if (Id == TEXT("Opacity") || Id == TEXT("PartOpacity"))
+	{
+		return ECubismMotionModelCurve::Opacity;
+	}
+
+	if (Id == TEXT("EyeBlink"))
+	{
+		return ECubismMotionModelCurve::EyeBlink;
+	}
+
+	if (Id == TEXT("LipSync"))
+	{
+		return ECubismMotionModelCurve::LipSync;
+	}
+
+	return ECubismMotionModelCurve::None;
+}
+
+TSharedPtr<const FCubismMotionData> UCubismMotion3Json::GetMotionData() const
+{
+	if (!MotionData.IsValid())
+	{
+		MotionData = MakeShared<const FCubismMotionData>(this);
+	}
+
+	return MotionData;
+}
+
+bool UCubismMotion3Json::LoadSegmentBulkData(FCubismMotionSegmentData& OutSegmentData) const
+{
+	const int64 Size = SegmentBulkData.GetBulkDataSize();
+
+	if (Size == 0)
+	{
+		return false;
+	}
+
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(Size);
+
+	void* Dest = Bytes.GetData();
+	SegmentBulkData.GetCopy(&Dest, true);
+
+	FMemoryReader Reader(Bytes);
+
+	int32 Version = 0;
+	Reader << Version;
+
+	if (Version != CubismSegmentBulkDataVersion)
+	{
+		UE_LOG(LogCubism, Warning, TEXT("UCubismMotion3Json: The packed segments of %s have an unknown version %d."), *GetName(), Version);
+		return false;
+	}
+
+	bool bCompressed = false;
+	Reader << bCompressed;
+
+	if (bCompressed)
+	{
+		FCubismCompressedMotionSegmentData CompressedData;
+		Reader << CompressedData;
+
+		if (Reader.IsError())
+		{
+			return false;
+		}
+
+		CompressedData.Decompress(OutSegmentData);
+	}
+	else
+	{
+		Reader << OutSegmentData.SegmentTypes;
+		Reader << OutSegmentData.SegmentBasePointIndices;
+		Reader << OutSegmentData.PointTimes;
+		Reader << OutSegmentData.PointValues;
+	}
+
+	return !Reader.IsError();
+}
+
+// UObject interface
+void UCubismMotion3Json::Serialize(FArchive& Ar)
+{
+	if (Ar.IsSaving() && Ar.IsFilterEditorOnly())
+	{
+		FCubismCompressedMotionSegmentData CompressedData;
+		FCubismMotionCompressionStats Stats;
+
+		bool bCompressed = CompressionSettings.bEnabled && FCubismMotionCompression::Compress(this, CompressedData, Stats);
+
+		if (bCompressed)
+		{
+			UE_LOG(LogCubism, Verbose, TEXT("UCubismMotion3Json: %s is compressed from %d to %d bytes. Max error: %f (%s), average error: %f"), *GetName(), Stats.UncompressedSize, Stats.CompressedSize, Stats.MaxError, *Stats.MaxErrorCurveId, Stats.AverageError);
+		}
+
+		// pack the segments in the bulk data instead of the tagged properties, so that they are not loaded with the package
+		TArray<ECubismMotionSegmentType> SavedSegmentTypes = MoveTemp(SegmentTypes);
+		TArray<int32> SavedSegmentBasePointIndices = MoveTemp(SegmentBasePointIndices);
+		TArray<float> SavedPointTimes = MoveTemp(PointTimes);
+		TArray<float> SavedPointValues = MoveTemp(PointValues);
+
+		TArray<uint8> Bytes;
+		{
+			FMemoryWriter Writer(Bytes);
+
+			int32 Version = CubismSegmentBulkDataVersion;
+			Writer << Version;
+
+			Writer << bCompressed;
+
+			if (bCompressed)
+			{
+				Writer << CompressedData;
+			}
+			else
+			{
+				Writer << SavedSegmentTypes;
+				Writer << SavedSegmentBasePointIndices;
+				Writer << SavedPointTimes;
+				Writer << SavedPointValues;
+			}
+		}
+
+		SegmentBulkData.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+		SegmentBulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(SegmentBulkData.Realloc(Bytes.Num()), Bytes.GetData(), Bytes.Num());
+		SegmentBulkData.Unlock();
+
+		Super::Serialize(Ar);
+
+		SegmentBulkData.Serialize(Ar, this);
+
+		SegmentTypes = MoveTemp(SavedSegmentTypes);
+		SegmentBasePointIndices = MoveTemp(SavedSegmentBasePointIndices);
+		PointTimes = MoveTemp(SavedPointTimes);
+		PointValues = MoveTemp(SavedPointValues);
+
+		return;
+	}
+
+	Super::Serialize(Ar);
+
+	if (Ar.IsLoading() && Ar.IsFilterEditorOnly())
+	{
+		SegmentBulkData.Serialize(Ar, this);
+	}
+}
+
+void UCubismMotion3Json::PostLoad()
+{
+	Super::PostLoad();
+
+	// the packed segments are loaded on the first play
+	if (SegmentBulkData.GetBulkDataSize() == 0)
+	{
+		MotionData = MakeShared<const FCubismMotionData>(this);
+	}
+}
+
+#if WITH_EDITOR
+void UCubismMotion3Json::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.MemberProperty ? PropertyChangedEvent.MemberProperty->GetFName() : NAME_None;
+
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismMotion3Json, CompressionSettings))
+	{
+		FCubismCompressedMotionSegmentData CompressedData;
+
+		CompressionStats = FCubismMotionCompressionStats();
+
+		if (CompressionSettings.bEnabled && FCubismMotionCompression::Compress(this, CompressedData, CompressionStats))
+		{
+			UE_LOG(LogCubism, Display, TEXT("UCubismMotion3Json: %s is compressed from %d to %d bytes. Max error: %f (%s), average error: %f"), *GetName(), CompressionStats.UncompressedSize, CompressionStats.CompressedSize, CompressionStats.MaxError, *CompressionStats.MaxErrorCurveId, CompressionStats.AverageError);
+		}
+	}
+
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismMotion3Json, bUsePoseCache))
+	{
+		// the motions already playing keep the previous data
+		MotionData = MakeShared<const FCubismMotionData>(this);
+	}
+}
+#endif
+// End of UObject interface
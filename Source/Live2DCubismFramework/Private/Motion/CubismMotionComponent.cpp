@@ -15,6 +15,32 @@
 #include "Model/CubismPartComponent.h"
 #include "Model/CubismModelActor.h"
 #include "CubismLog.h"
+#include "CubismStats.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+	/**
+	 * The maximum number of the parameters of an effect modulated by the motions, as in the Cubism SDK for Native.
+	 */
+	constexpr int32 CubismEffectParameterMaxCount = 64;
+
+	/**
+	 * @brief The function to clamp a value to the range of a parameter.
+	 * @param Parameter The parameter that has the range.
+	 * @param Value The value to clamp.
+	 * @return The clamped value.
+	 */
+	float ClampParameterValue(const UCubismParameterComponent* Parameter, const float Value)
+	{
+		if (!FGenericPlatformMath::IsNaN(Parameter->MinimumValue) && !FGenericPlatformMath::IsNaN(Parameter->MaximumValue))
+		{
+			return FMath::Clamp(Value, Parameter->MinimumValue, Parameter->MaximumValue);
+		}
+
+		return Value;
+	}
+}
 
 UCubismMotionComponent::UCubismMotionComponent()
 {
@@ -33,8 +59,15 @@ void UCubismMotionComponent::Setup(UCubismModelComponent* InModel)
 	}
 
 	Time = 0.0f;
+	TimeAccumulator = 0.0f;
 	MotionQueue.Empty();
 
+	for (FCubismMotionLayer& Layer : Layers)
+	{
+		Layer.MotionQueue.Empty();
+		Layer.ParameterMask.Empty();
+	}
+
 	Model->Motion = this;
 
 	AddTickPrerequisiteComponent(Model->ParameterStore); // must be updated after parameters loaded
@@ -89,16 +122,115 @@ void UCubismMotionComponent::PlayMotion(const int32 InIndex, const float OffsetT
 		Motion->SetFadeout(Motion->FadeOutTime);
 	}
 
-	TSharedPtr<FCubismMotion> NextMotion = MakeShared<FCubismMotion>(Json, OffsetTime);
+	MotionQueue.Add(AcquireMotion(Json, OffsetTime));
+}
+
+void UCubismMotionComponent::SeekMotions(const float MotionTime)
+{
+	for (const TSharedPtr<FCubismMotion>& Motion : MotionQueue)
+	{
+		SeekMotion(*Motion, MotionTime);
+	}
+
+	for (const FCubismMotionLayer& Layer : Layers)
+	{
+		for (const TSharedPtr<FCubismMotion>& Motion : Layer.MotionQueue)
+		{
+			SeekMotion(*Motion, MotionTime);
+		}
+	}
+}
+
+void UCubismMotionComponent::SeekMotion(FCubismMotion& CubismMotion, const float MotionTime)
+{
+	if (CubismMotion.State == ECubismMotionState::None)
+	{
+		CubismMotion.Init(Time);
+	}
+
+	const float TimeOffsetSeconds = FMath::Max(MotionTime, 0.0f);
+
+	CubismMotion.StartTime = Time - TimeOffsetSeconds;
 
-	MotionQueue.Add(NextMotion);
+	// Skip the events before the time, and keep the segment cursors, which restart the search by themselves if the time went back.
+	const float LoopedTime = CubismMotion.bLoop && CubismMotion.Duration > 0.0f && TimeOffsetSeconds > CubismMotion.Duration
+		? FMath::Fmod(TimeOffsetSeconds, CubismMotion.Duration)
+		: TimeOffsetSeconds;
+
+	CubismMotion.LastEventTime = LoopedTime;
+	CubismMotion.EventCursor = Algo::UpperBound(CubismMotion.Data->EventTimes, LoopedTime);
+}
+
+int32 UCubismMotionComponent::FindGroup(const FName GroupName) const
+{
+	return Groups.IndexOfByPredicate([GroupName](const FCubismMotionGroup& Group) { return Group.Name == GroupName; });
+}
+
+int32 UCubismMotionComponent::PlayRandomInGroup(const FName GroupName, const float OffsetTime, const ECubismMotionPriority Priority)
+{
+	const int32 GroupIndex = FindGroup(GroupName);
+
+	if (GroupIndex == INDEX_NONE || Groups[GroupIndex].Indices.Num() == 0)
+	{
+		UE_LOG(LogCubism, Warning, TEXT("Motion cannot be played. Group %s is not found or empty."), *GroupName.ToString());
+
+		return INDEX_NONE;
+	}
+
+	return PlayInGroup(GroupIndex, FMath::RandRange(0, Groups[GroupIndex].Indices.Num() - 1), OffsetTime, Priority);
+}
+
+int32 UCubismMotionComponent::PlayNextInGroup(const FName GroupName, const float OffsetTime, const ECubismMotionPriority Priority)
+{
+	const int32 GroupIndex = FindGroup(GroupName);
+
+	if (GroupIndex == INDEX_NONE || Groups[GroupIndex].Indices.Num() == 0)
+	{
+		UE_LOG(LogCubism, Warning, TEXT("Motion cannot be played. Group %s is not found or empty."), *GroupName.ToString());
+
+		return INDEX_NONE;
+	}
+
+	FCubismMotionGroup& Group = Groups[GroupIndex];
+
+	const int32 Position = Group.NextPosition % Group.Indices.Num();
+
+	const int32 PlayedIndex = PlayInGroup(GroupIndex, Position, OffsetTime, Priority);
+
+	if (PlayedIndex != INDEX_NONE)
+	{
+		Group.NextPosition = (Position + 1) % Group.Indices.Num();
+	}
+
+	return PlayedIndex;
+}
+
+int32 UCubismMotionComponent::PlayInGroup(const int32 GroupIndex, const int32 Position, const float OffsetTime, const ECubismMotionPriority Priority)
+{
+	const int32 JsonIndex = Groups[GroupIndex].Indices[Position];
+
+	if (!Jsons.IsValidIndex(JsonIndex))
+	{
+		UE_LOG(LogCubism, Warning, TEXT("Motion cannot be played. Index is out of range."));
+
+		return INDEX_NONE;
+	}
+
+	if (Priority != ECubismMotionPriority::Force && !ReserveMotion(Priority))
+	{
+		return INDEX_NONE;
+	}
+
+	PlayMotion(JsonIndex, OffsetTime, Priority);
+
+	return JsonIndex;
 }
 
 void UCubismMotionComponent::StopAllMotions(const bool bForce)
 {
 	if (bForce)
 	{
-		MotionQueue.Empty();
+		ReleaseMotions(MotionQueue);
 	}
 	else
 	{
@@ -107,6 +239,127 @@ void UCubismMotionComponent::StopAllMotions(const bool bForce)
 			Motion->FadeOut(Time);
 		}
 	}
+
+	for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); LayerIndex++)
+	{
+		StopAllMotionsInLayer(LayerIndex, bForce);
+	}
+}
+
+bool UCubismMotionComponent::IsLayerFinished(const int32 LayerIndex) const
+{
+	if (!Layers.IsValidIndex(LayerIndex))
+	{
+		return true;
+	}
+
+	for (const TSharedPtr<FCubismMotion>& Motion : Layers[LayerIndex].MotionQueue)
+	{
+		if (Motion->State != ECubismMotionState::End)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UCubismMotionComponent::PlayMotionInLayer(const int32 LayerIndex, const int32 InIndex, const float OffsetTime)
+{
+	if (!Layers.IsValidIndex(LayerIndex))
+	{
+		UE_LOG(LogCubism, Warning, TEXT("Motion cannot be played. Layer index is out of range."));
+
+		return;
+	}
+
+	if (!Jsons.IsValidIndex(InIndex))
+	{
+		UE_LOG(LogCubism, Warning, TEXT("Motion cannot be played. Index is out of range."));
+
+		return;
+	}
+
+	FCubismMotionLayer& Layer = Layers[LayerIndex];
+
+	for (const TSharedPtr<FCubismMotion>& Motion : Layer.MotionQueue)
+	{
+		Motion->SetFadeout(Motion->FadeOutTime);
+	}
+
+	Layer.MotionQueue.Add(AcquireMotion(Jsons[InIndex], OffsetTime));
+
+	// The parameter IDs may have been changed since the last motion.
+	UpdateLayerMask(Layer);
+}
+
+void UCubismMotionComponent::StopAllMotionsInLayer(const int32 LayerIndex, const bool bForce)
+{
+	if (!Layers.IsValidIndex(LayerIndex))
+	{
+		return;
+	}
+
+	FCubismMotionLayer& Layer = Layers[LayerIndex];
+
+	if (bForce)
+	{
+		ReleaseMotions(Layer.MotionQueue);
+	}
+	else
+	{
+		for (const TSharedPtr<FCubismMotion>& Motion : Layer.MotionQueue)
+		{
+			Motion->FadeOut(Time);
+		}
+	}
+}
+
+TSharedPtr<FCubismMotion> UCubismMotionComponent::AcquireMotion(const UCubismMotion3Json* Json, const float OffsetTime)
+{
+	TSharedPtr<FCubismMotion> Motion;
+
+	if (MotionPool.Num() > 0)
+	{
+		Motion = MotionPool.Pop(false);
+		Motion->Reset(Json, OffsetTime);
+	}
+	else
+	{
+		Motion = MakeShared<FCubismMotion>(Json, OffsetTime);
+	}
+
+	Motion->Bind(Model);
+
+	return Motion;
+}
+
+void UCubismMotionComponent::ReleaseMotions(TArray<TSharedPtr<FCubismMotion>>& Queue)
+{
+	MotionPool.Append(Queue);
+
+	Queue.Reset();
+}
+
+void UCubismMotionComponent::UpdateLayerMask(FCubismMotionLayer& Layer) const
+{
+	// Parameters not found in the model are ignored rather than added, as the mask does not write them.
+	Layer.ParameterMask.Init(Layer.ParameterIds.Num() == 0, Model->Parameters.Num());
+
+	if (Layer.ParameterIds.Num() == 0)
+	{
+		return;
+	}
+
+	for (int32 ParameterIndex = 0; ParameterIndex < Model->Parameters.Num(); ParameterIndex++)
+	{
+		const UCubismParameterComponent* Parameter = Model->Parameters[ParameterIndex];
+
+		if (Parameter && Layer.ParameterIds.Contains(Parameter->Id))
+		{
+			Layer.ParameterMask[ParameterIndex] = true;
+		}
+	}
 }
 
 // UObject interface
@@ -130,6 +383,14 @@ void UCubismMotionComponent::PostEditChangeProperty(struct FPropertyChangedEvent
 	{
 		PlayMotion(Index, 0.0f, ECubismMotionPriority::Force);
 	}
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UCubismMotionComponent, Layers))
+	{
+		for (FCubismMotionLayer& Layer : Layers)
+		{
+			Layer.ParameterMask.Empty();
+		}
+	}
 }
 #endif
 // End of UObject interface
@@ -158,11 +419,122 @@ void UCubismMotionComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	Time += Speed * DeltaTime;
+	SCOPE_CYCLE_COUNTER(STAT_CubismMotionUpdate);
+	INC_DWORD_STAT(STAT_CubismMotionComponents);
+
+	if (FixedTimeStep > 0.0f)
+	{
+		// Advance by whole steps only and carry the rest over, so that the motions are sampled at the same times regardless of the frame rate.
+		TimeAccumulator += Speed * DeltaTime;
+
+		const float StepCount = FMath::FloorToFloat(TimeAccumulator / FixedTimeStep);
+
+		TimeAccumulator -= StepCount * FixedTimeStep;
+		Time += StepCount * FixedTimeStep;
+	}
+	else
+	{
+		Time += Speed * DeltaTime;
+	}
+
+	const int32 ParameterCount = Model->Parameters.Num();
+
+	// Read the parameters once, blend all layers into the buffer and write back only the parameters blended.
+	ParameterValues.SetNumUninitialized(ParameterCount);
+
+	for (int32 ParameterIndex = 0; ParameterIndex < ParameterCount; ParameterIndex++)
+	{
+		ParameterValues[ParameterIndex] = Model->GetParameterValue(ParameterIndex);
+	}
+
+	BlendedParameters.Init(false, ParameterCount);
+
+	UpdateMotionQueue(MotionQueue, 1.0f, ParameterValues, BlendedParameters);
 
-	for (int32 i = 0; i < MotionQueue.Num();)
+	for (FCubismMotionLayer& Layer : Layers)
 	{
-		TSharedPtr<FCubismMotion>& Motion = MotionQueue[i];
+		if (Layer.MotionQueue.Num() == 0)
+		{
+			continue;
+		}
+
+		if (Layer.ParameterMask.Num() != ParameterCount)
+		{
+			UpdateLayerMask(Layer);
+		}
+
+		const bool bAdditive = Layer.BlendMode == ECubismMotionLayerBlendMode::Additive;
+
+		if (bAdditive)
+		{
+			LayerParameterValues.SetNumUninitialized(ParameterCount);
+
+			for (int32 ParameterIndex = 0; ParameterIndex < ParameterCount; ParameterIndex++)
+			{
+				LayerParameterValues[ParameterIndex] = Model->Parameters[ParameterIndex]->DefaultValue;
+			}
+		}
+		else
+		{
+			LayerParameterValues = ParameterValues;
+		}
+
+		LayerBlendedParameters.Init(false, ParameterCount);
+
+		UpdateMotionQueue(Layer.MotionQueue, bAdditive? 0.0f : Layer.Weight, LayerParameterValues, LayerBlendedParameters);
+
+		for (TConstSetBitIterator<> It(LayerBlendedParameters); It; ++It)
+		{
+			const int32 ParameterIndex = It.GetIndex();
+
+			if (!Layer.ParameterMask[ParameterIndex])
+			{
+				continue;
+			}
+
+			const UCubismParameterComponent* Parameter = Model->Parameters[ParameterIndex];
+
+			const float LayerValue = bAdditive
+				? ParameterValues[ParameterIndex] + (LayerParameterValues[ParameterIndex] - Parameter->DefaultValue) * Layer.Weight
+				: ParameterValues[ParameterIndex] + (LayerParameterValues[ParameterIndex] - ParameterValues[ParameterIndex]) * Layer.Weight;
+
+			ParameterValues[ParameterIndex] = ClampParameterValue(Parameter, LayerValue);
+			BlendedParameters[ParameterIndex] = true;
+		}
+	}
+
+	for (TConstSetBitIterator<> It(BlendedParameters); It; ++It)
+	{
+		Model->Parameters[It.GetIndex()]->SetParameterValue(ParameterValues[It.GetIndex()]);
+	}
+
+	for (const FName& Event : FiredEvents)
+	{
+		OnMotionEventNative.Broadcast(Event);
+		OnMotionEvent.Broadcast(Event);
+	}
+
+	FiredEvents.Reset();
+
+	if (IsFinished())
+	{
+		CurrentPriority = ECubismMotionPriority::None;
+
+		OnMotionPlaybackFinished.Broadcast();
+	}
+}
+// End of UActorComponent interface
+
+void UCubismMotionComponent::UpdateMotionQueue(TArray<TSharedPtr<FCubismMotion>>& Queue, const float ModelWeight, TArray<float>& Values, TBitArray<>& BlendedFlags)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UCubismMotionComponent::UpdateMotionQueue);
+	INC_DWORD_STAT_BY(STAT_CubismQueuedMotions, Queue.Num());
+
+	BlendList.Reset();
+
+	for (int32 i = 0; i < Queue.Num();)
+	{
+		TSharedPtr<FCubismMotion>& Motion = Queue[i];
 
 		if (Motion->State == ECubismMotionState::None)
 		{
@@ -172,11 +544,15 @@ void UCubismMotionComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 
 		float FadeWeight = Motion->UpdateFadeWeight(Motion, Time);
 
-		UpdateMotion(Time, FadeWeight, Motion);
+		INC_DWORD_STAT(STAT_CubismActiveMotions);
+
+		UpdateMotion(Time, FadeWeight, Motion, ModelWeight);
 
 		if (Motion->IsFinished())
 		{
-			MotionQueue.RemoveAt(i);
+			MotionPool.Add(Motion);
+
+			Queue.RemoveAt(i, 1, false);
 		}
 		else
 		{
@@ -189,16 +565,43 @@ void UCubismMotionComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 		}
 	}
 
-	if (IsFinished())
+	ApplyBlendList(Values, BlendedFlags);
+}
+
+void UCubismMotionComponent::ApplyBlendList(TArray<float>& Values, TBitArray<>& BlendedFlags)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UCubismMotionComponent::ApplyBlendList);
+
+	// Group the values by the parameters, keeping the order of the motions in the queue.
+	BlendList.StableSort(
+		[](const FCubismMotionBlend& A, const FCubismMotionBlend& B)
+		{
+			return A.ParameterIndex < B.ParameterIndex;
+		}
+	);
+
+	for (int32 i = 0; i < BlendList.Num();)
 	{
-		CurrentPriority = ECubismMotionPriority::None;
+		const int32 ParameterIndex = BlendList[i].ParameterIndex;
+		const UCubismParameterComponent* Parameter = Model->GetParameter(ParameterIndex);
 
-		OnMotionPlaybackFinished.Broadcast();
+		float Value = Values[ParameterIndex];
+
+		for (; i < BlendList.Num() && BlendList[i].ParameterIndex == ParameterIndex; i++)
+		{
+			const FCubismMotionBlend& Blend = BlendList[i];
+
+			Value = ClampParameterValue(Parameter, Blend.bOverride? Blend.Value : Value + (Blend.Value - Value) * Blend.Weight);
+		}
+
+		Values[ParameterIndex] = Value;
+		BlendedFlags[ParameterIndex] = true;
 	}
+
+	BlendList.Reset();
 }
-// End of UActorComponent interface
 
-void UCubismMotionComponent::UpdateMotion(float UserTimeSeconds, float FadeWeight, const TSharedPtr<FCubismMotion>& CubismMotion)
+void UCubismMotionComponent::UpdateMotion(float UserTimeSeconds, float FadeWeight, const TSharedPtr<FCubismMotion>& CubismMotion, const float ModelWeight)
 {
 	float TimeOffsetSeconds = UserTimeSeconds - CubismMotion->StartTime;
 
@@ -218,42 +621,77 @@ void UCubismMotionComponent::UpdateMotion(float UserTimeSeconds, float FadeWeigh
 	// 'Repeat' time as necessary.
 	float MotionTime = TimeOffsetSeconds;
 
-	if (CubismMotion->State == ECubismMotionState::PlayInLoop)
+	if (CubismMotion->State == ECubismMotionState::PlayInLoop && CubismMotion->Duration > 0.0f && MotionTime > CubismMotion->Duration)
 	{
-		while (MotionTime > CubismMotion->Duration)
-		{
-			MotionTime -= CubismMotion->Duration;
-		}
+		MotionTime = FMath::Fmod(MotionTime, CubismMotion->Duration);
 	}
 
-	TArray<FCubismMotionCurve> Curves = CubismMotion->Curves;
+	const FCubismMotionData& Data = *CubismMotion->Data;
+
+	// Evaluate all curves at once.
+	CubismMotion->EvaluateCurves(MotionTime);
+
+	CollectEvents(*CubismMotion, MotionTime);
+
+	// The values of the effect curves, applied to the parameters of the effects.
+	bool bHasEyeBlink = false;
+	bool bHasLipSync = false;
+	float EyeBlinkValue = 0.0f;
+	float LipSyncValue = 0.0f;
 
 	// Evaluate model curves.
-	for (const FCubismMotionCurve& Curve : Curves)
+	for (const int32 CurveIndex : Data.ModelCurveIndices)
 	{
-		if (Curve.Target != ECubismMotionCurveTarget::Model)
+		const FCubismMotionCurve& Curve = Data.Curves[CurveIndex];
+
+		if (ModelWeight <= 0.0f)
 		{
-			continue;
+			break;
 		}
 
-		// Evaluate curve and call handler.
-		float Value = CubismMotion->GetValue(Curve.Id, MotionTime);
+		// Call handler with the evaluated value.
+		float Value = CubismMotion->CurveValues[CurveIndex];
 
-		if (Curve.Id == "PartOpacity")
+		switch (Curve.ModelCurve)
 		{
-			Model->Opacity = Value;
+			case ECubismMotionModelCurve::Opacity:
+			{
+				Model->Opacity = ModelWeight == 1.0f? Value : FMath::Lerp(Model->Opacity, Value, ModelWeight);
+				break;
+			}
+			case ECubismMotionModelCurve::EyeBlink:
+			{
+				bHasEyeBlink = true;
+				EyeBlinkValue = Value;
+				break;
+			}
+			case ECubismMotionModelCurve::LipSync:
+			{
+				bHasLipSync = true;
+				LipSyncValue = Value;
+				break;
+			}
+			default:
+			{
+				break;
+			}
 		}
 	}
 
-	for (const FCubismMotionCurve& Curve : Curves)
+	const TArray<int32>& EyeBlinkParameterIndices = Model->EyeBlinkParameterIndices;
+	const TArray<int32>& LipSyncParameterIndices = Model->LipSyncParameterIndices;
+
+	// The flags of the parameters of the effects already modulated by the parameter curves.
+	uint64 EyeBlinkFlags = 0;
+	uint64 LipSyncFlags = 0;
+
+	for (const int32 CurveIndex : Data.ParameterCurveIndices)
 	{
-		if (Curve.Target != ECubismMotionCurveTarget::Parameter)
-		{
-			continue;
-		}
+		const FCubismMotionCurve& Curve = Data.Curves[CurveIndex];
 
 		// Find parameter.
-		UCubismParameterComponent* Parameter = Model->GetParameter(Curve.Id);
+		const int32 ParameterIndex = CubismMotion->ParameterIndices[CurveIndex];
+		const UCubismParameterComponent* Parameter = Model->GetParameter(ParameterIndex);
 
 		// Skip curve evaluation if no value in sink.
 		if (!Parameter)
@@ -261,18 +699,42 @@ void UCubismMotionComponent::UpdateMotion(float UserTimeSeconds, float FadeWeigh
 			continue;
 		}
 
-		const float SourceValue = Parameter->GetParameterValue();
+		// Apply the evaluated value.
+		float Value = CubismMotion->CurveValues[CurveIndex];
 
-		// Evaluate curve and apply value.
-		float Value = CubismMotion->GetValue(Curve.Id, MotionTime);
+		// Scale the eye blink parameters and offset the lip sync parameters by the effect curves.
+		if (bHasEyeBlink)
+		{
+			for (int32 i = 0; i < EyeBlinkParameterIndices.Num() && i < CubismEffectParameterMaxCount; i++)
+			{
+				if (EyeBlinkParameterIndices[i] == ParameterIndex)
+				{
+					Value *= EyeBlinkValue;
+					EyeBlinkFlags |= 1ull << i;
+					break;
+				}
+			}
+		}
 
+		if (bHasLipSync)
+		{
+			for (int32 i = 0; i < LipSyncParameterIndices.Num() && i < CubismEffectParameterMaxCount; i++)
+			{
+				if (LipSyncParameterIndices[i] == ParameterIndex)
+				{
+					Value += LipSyncValue;
+					LipSyncFlags |= 1ull << i;
+					break;
+				}
+			}
+		}
 
-		float NewValue;
+		float Weight;
 		// Fade per parameter.
 		if (Curve.FadeInTime < 0.0f && Curve.FadeOutTime < 0.0f)
 		{
 			//Apply motion fade.
-			NewValue = SourceValue + (Value - SourceValue) * FadeWeight;
+			Weight = FadeWeight;
 		}
 		else
 		{
@@ -302,24 +764,47 @@ void UCubismMotionComponent::UpdateMotion(float UserTimeSeconds, float FadeWeigh
 					: FCubismMotion::EasingSin((UserTimeSeconds - CubismMotion->EndTime) / Curve.FadeOutTime);
 			}
 
-			const float ParamWeight = CubismMotion->GetWeight() * FadeInWeight * FadeOutWeight;
-
 			// Apply fade per parameter.
-			NewValue = SourceValue + (Value - SourceValue) * ParamWeight;
+			Weight = CubismMotion->GetWeight() * FadeInWeight * FadeOutWeight;
 		}
 
-		Parameter->SetParameterValue(NewValue);
+		BlendList.Add({ParameterIndex, Value, Weight, false});
 	}
 
-	for (const FCubismMotionCurve& Curve : Curves)
+	// The parameters of the effects without their own curves take the values of the effect curves.
+	if (bHasEyeBlink)
 	{
-		if (Curve.Target != ECubismMotionCurveTarget::PartOpacity)
+		for (int32 i = 0; i < EyeBlinkParameterIndices.Num() && i < CubismEffectParameterMaxCount; i++)
 		{
-			continue;
+			if (((EyeBlinkFlags >> i) & 1) || !Model->GetParameter(EyeBlinkParameterIndices[i]))
+			{
+				continue;
+			}
+
+			BlendList.Add({EyeBlinkParameterIndices[i], EyeBlinkValue, FadeWeight, false});
 		}
+	}
+
+	if (bHasLipSync)
+	{
+		for (int32 i = 0; i < LipSyncParameterIndices.Num() && i < CubismEffectParameterMaxCount; i++)
+		{
+			if (((LipSyncFlags >> i) & 1) || !Model->GetParameter(LipSyncParameterIndices[i]))
+			{
+				continue;
+			}
+
+			BlendList.Add({LipSyncParameterIndices[i], LipSyncValue, FadeWeight, false});
+		}
+	}
+
+	for (const int32 CurveIndex : Data.PartOpacityCurveIndices)
+	{
+		const FCubismMotionCurve& Curve = Data.Curves[CurveIndex];
 
 		// Find parameter.
-		UCubismParameterComponent* Parameter = Model->GetParameter(Curve.Id);
+		const int32 ParameterIndex = CubismMotion->ParameterIndices[CurveIndex];
+		const UCubismParameterComponent* Parameter = Model->GetParameter(ParameterIndex);
 
 		// Skip curve evaluation if no value in sink.
 		if (!Parameter)
@@ -327,10 +812,10 @@ void UCubismMotionComponent::UpdateMotion(float UserTimeSeconds, float FadeWeigh
 			continue;
 		}
 
-		// Evaluate curve and apply value.
-		float Value = CubismMotion->GetValue(Curve.Id, MotionTime);
+		// Apply the evaluated value.
+		float Value = CubismMotion->CurveValues[CurveIndex];
 
-		Parameter->SetParameterValue(Value);
+		BlendList.Add({ParameterIndex, Value, 1.0f, true});
 	}
 
 	if ((CubismMotion->GetEndTime() > 0.0f) && (CubismMotion->GetEndTime() < UserTimeSeconds))
@@ -342,7 +827,10 @@ void UCubismMotionComponent::UpdateMotion(float UserTimeSeconds, float FadeWeigh
 	{
 		if (CubismMotion->State == ECubismMotionState::PlayInLoop)
 		{
-			CubismMotion->StartTime = UserTimeSeconds;
+			// Keep the phase of the loop, so that the motion stays in sync after a long tick or a seek.
+			CubismMotion->StartTime = CubismMotion->Duration > 0.0f
+				? UserTimeSeconds - FMath::Fmod(UserTimeSeconds - CubismMotion->StartTime, CubismMotion->Duration)
+				: UserTimeSeconds;
 		}
 		else
 		{
@@ -350,3 +838,32 @@ void UCubismMotionComponent::UpdateMotion(float UserTimeSeconds, float FadeWeigh
 		}
 	}
 }
+
+void UCubismMotionComponent::CollectEvents(FCubismMotion& CubismMotion, const float MotionTime)
+{
+	const FCubismMotionData& Data = *CubismMotion.Data;
+	const int32 EventCount = Data.EventTimes.Num();
+
+	if (EventCount == 0)
+	{
+		return;
+	}
+
+	if (MotionTime < CubismMotion.LastEventTime)
+	{
+		// The motion has looped.
+		for (; CubismMotion.EventCursor < EventCount; CubismMotion.EventCursor++)
+		{
+			FiredEvents.Add(Data.EventValues[CubismMotion.EventCursor]);
+		}
+
+		CubismMotion.EventCursor = 0;
+	}
+
+	for (; CubismMotion.EventCursor < EventCount && Data.EventTimes[CubismMotion.EventCursor] <= MotionTime; CubismMotion.EventCursor++)
+	{
+		FiredEvents.Add(Data.EventValues[CubismMotion.EventCursor]);
+	}
+
+	CubismMotion.LastEventTime = MotionTime;
+}
@@ -0,0 +1,350 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Motion/CubismMotionCompression.h"
+
+#include "CubismLog.h"
+
+namespace
+{
+	/**
+	 * The number of steps of the quantized times in a frame.
+	 * The points on the frames are kept exact, and the control points of the Bezier segments keep sub-frame precision.
+	 */
+	constexpr int32 CubismTimeStepsPerFrame = 16;
+
+	/**
+	 * The number of samples per frame to measure the errors of the compression.
+	 */
+	constexpr int32 CubismErrorSamplesPerFrame = 4;
+
+	int32 GetSegmentEndPointIndex(const TArray<ECubismMotionSegmentType>& SegmentTypes, const TArray<int32>& SegmentBasePointIndices, const int32 SegmentIndex)
+	{
+		return SegmentBasePointIndices[SegmentIndex] + (SegmentTypes[SegmentIndex] == ECubismMotionSegmentType::Bezier? 3 : 1);
+	}
+}
+
+void FCubismCompressedMotionSegmentData::Decompress(FCubismMotionSegmentData& OutSegmentData) const
+{
+	OutSegmentData.CurveBaseSegmentIndices = CurveBaseSegmentIndices;
+	OutSegmentData.CurveSegmentCounts = CurveSegmentCounts;
+	OutSegmentData.SegmentTypes = SegmentTypes;
+	OutSegmentData.SegmentBasePointIndices = SegmentBasePointIndices;
+
+	if (TimeStep > 0.0f)
+	{
+		OutSegmentData.PointTimes.SetNumUninitialized(QuantizedPointTimes.Num());
+
+		for (int32 PointIndex = 0; PointIndex < QuantizedPointTimes.Num(); PointIndex++)
+		{
+			OutSegmentData.PointTimes[PointIndex] = QuantizedPointTimes[PointIndex] * TimeStep;
+		}
+	}
+	else
+	{
+		OutSegmentData.PointTimes = PointTimes;
+	}
+
+	if (CurveValueSteps.Num() > 0)
+	{
+		OutSegmentData.PointValues.SetNumZeroed(QuantizedPointValues.Num());
+
+		for (int32 CurveIndex = 0; CurveIndex < CurveBaseSegmentIndices.Num(); CurveIndex++)
+		{
+			const int32 BaseSegmentIndex = CurveBaseSegmentIndices[CurveIndex];
+			const int32 FirstPointIndex = SegmentBasePointIndices[BaseSegmentIndex];
+			const int32 LastPointIndex = GetSegmentEndPointIndex(SegmentTypes, SegmentBasePointIndices, BaseSegmentIndex + CurveSegmentCounts[CurveIndex] - 1);
+
+			for (int32 PointIndex = FirstPointIndex; PointIndex <= LastPointIndex; PointIndex++)
+			{
+				OutSegmentData.PointValues[PointIndex] = CurveMinimumValues[CurveIndex] + QuantizedPointValues[PointIndex] * CurveValueSteps[CurveIndex];
+			}
+		}
+	}
+	else
+	{
+		OutSegmentData.PointValues = PointValues;
+	}
+}
+
+int32 FCubismCompressedMotionSegmentData::GetSize() const
+{
+	return (CurveBaseSegmentIndices.Num() + CurveSegmentCounts.Num() + SegmentBasePointIndices.Num()) * sizeof(int32)
+		+ SegmentTypes.Num() * sizeof(ECubismMotionSegmentType)
+		+ sizeof(TimeStep)
+		+ (QuantizedPointTimes.Num() + QuantizedPointValues.Num()) * sizeof(uint16)
+		+ (PointTimes.Num() + PointValues.Num() + CurveMinimumValues.Num() + CurveValueSteps.Num()) * sizeof(float);
+}
+
+FArchive& operator<<(FArchive& Ar, FCubismCompressedMotionSegmentData& SegmentData)
+{
+	Ar << SegmentData.CurveBaseSegmentIndices;
+	Ar << SegmentData.CurveSegmentCounts;
+	Ar << SegmentData.SegmentTypes;
+	Ar << SegmentData.SegmentBasePointIndices;
+	Ar << SegmentData.TimeStep;
+	Ar << SegmentData.QuantizedPointTimes;
+	Ar << SegmentData.PointTimes;
+	Ar << SegmentData.CurveMinimumValues;
+	Ar << SegmentData.CurveValueSteps;
+	Ar << SegmentData.QuantizedPointValues;
+	Ar << SegmentData.PointValues;
+
+	return Ar;
+}
+
+bool FCubismMotionCompression::Compress(const UCubismMotion3Json* Json, FCubismCompressedMotionSegmentData& OutSegmentData, FCubismMotionCompressionStats& OutStats)
+{
+	check(Json);
+
+	const FCubismMotionCompressionSettings& Settings = Json->CompressionSettings;
+
+	OutSegmentData = FCubismCompressedMotionSegmentData();
+	OutStats = FCubismMotionCompressionStats();
+
+	FCubismMotionSegmentData SourceData;
+	SourceData.SegmentTypes = Json->SegmentTypes;
+	SourceData.SegmentBasePointIndices = Json->SegmentBasePointIndices;
+	SourceData.PointTimes = Json->PointTimes;
+	SourceData.PointValues = Json->PointValues;
+
+	const FCubismMotionData Uncompressed(Json, MoveTemp(SourceData));
+
+	if (!Uncompressed.bUseSegments)
+	{
+		return false;
+	}
+
+	FCubismMotionSegmentData ReducedData;
+	OutStats.RemovedPointCount = RemoveLinearPoints(Json, Settings.LinearTolerance, ReducedData);
+
+	OutSegmentData.CurveBaseSegmentIndices = ReducedData.CurveBaseSegmentIndices;
+	OutSegmentData.CurveSegmentCounts = ReducedData.CurveSegmentCounts;
+	OutSegmentData.SegmentTypes = ReducedData.SegmentTypes;
+	OutSegmentData.SegmentBasePointIndices = ReducedData.SegmentBasePointIndices;
+
+	// quantize the times to the steps in the frames
+	bool bQuantizeTimes = Settings.bQuantizeTimes && Json->Fps > 0.0f;
+
+	const float TimeStep = bQuantizeTimes? 1.0f / (Json->Fps * CubismTimeStepsPerFrame) : 0.0f;
+
+	for (const float PointTime : ReducedData.PointTimes)
+	{
+		if (!bQuantizeTimes)
+		{
+			break;
+		}
+
+		bQuantizeTimes = PointTime >= 0.0f && FMath::RoundToInt(PointTime / TimeStep) <= MAX_uint16;
+	}
+
+	if (bQuantizeTimes)
+	{
+		OutSegmentData.TimeStep = TimeStep;
+		OutSegmentData.QuantizedPointTimes.SetNumUninitialized(ReducedData.PointTimes.Num());
+
+		for (int32 PointIndex = 0; PointIndex < ReducedData.PointTimes.Num(); PointIndex++)
+		{
+			OutSegmentData.QuantizedPointTimes[PointIndex] = (uint16)FMath::RoundToInt(ReducedData.PointTimes[PointIndex] / TimeStep);
+		}
+	}
+	else
+	{
+		if (Settings.bQuantizeTimes)
+		{
+			UE_LOG(LogCubism, Warning, TEXT("FCubismMotionCompression: The times of %s are out of the range of the quantization."), *Json->GetName());
+		}
+
+		OutSegmentData.PointTimes = ReducedData.PointTimes;
+	}
+
+	// quantize the values to 16 bits in the range of each curve
+	if (Settings.bQuantizeValues)
+	{
+		OutSegmentData.QuantizedPointValues.SetNumZeroed(ReducedData.PointValues.Num());
+
+		for (int32 CurveIndex = 0; CurveIndex < ReducedData.CurveBaseSegmentIndices.Num(); CurveIndex++)
+		{
+			const int32 BaseSegmentIndex = ReducedData.CurveBaseSegmentIndices[CurveIndex];
+			const int32 FirstPointIndex = ReducedData.SegmentBasePointIndices[BaseSegmentIndex];
+			const int32 LastPointIndex = GetSegmentEndPointIndex(ReducedData.SegmentTypes, ReducedData.SegmentBasePointIndices, BaseSegmentIndex + ReducedData.CurveSegmentCounts[CurveIndex] - 1);
+
+			float MinimumValue = ReducedData.PointValues[FirstPointIndex];
+			float MaximumValue = ReducedData.PointValues[FirstPointIndex];
+
+			for (int32 PointIndex = FirstPointIndex; PointIndex <= LastPointIndex; PointIndex++)
+			{
+				MinimumValue = FMath::Min(MinimumValue, ReducedData.PointValues[PointIndex]);
+				MaximumValue = FMath::Max(MaximumValue, ReducedData.PointValues[PointIndex]);
+			}
+
+			const float ValueStep = (MaximumValue - MinimumValue) / MAX_uint16;
+
+			OutSegmentData.CurveMinimumValues.Add(MinimumValue);
+			OutSegmentData.CurveValueSteps.Add(ValueStep);
+
+			if (ValueStep <= 0.0f)
+			{
+				continue;
+			}
+
+			for (int32 PointIndex = FirstPointIndex; PointIndex <= LastPointIndex; PointIndex++)
+			{
+				OutSegmentData.QuantizedPointValues[PointIndex] = (uint16)FMath::Clamp(FMath::RoundToInt((ReducedData.PointValues[PointIndex] - MinimumValue) / ValueStep), 0, (int32)MAX_uint16);
+			}
+		}
+	}
+	else
+	{
+		OutSegmentData.PointValues = ReducedData.PointValues;
+	}
+
+	// measure the errors against the uncompressed curves
+	FCubismMotionSegmentData DecompressedData;
+	OutSegmentData.Decompress(DecompressedData);
+
+	const FCubismMotionData Compressed(Json, MoveTemp(DecompressedData));
+
+	if (!ensure(Compressed.bUseSegments))
+	{
+		return false;
+	}
+
+	const float SampleStep = 1.0f / (FMath::Max(Json->Fps, 1.0f) * CubismErrorSamplesPerFrame);
+	const int32 SampleCount = FMath::CeilToInt(Json->Duration / SampleStep) + 1;
+
+	double ErrorSum = 0.0;
+	int32 ErrorCount = 0;
+
+	for (int32 CurveIndex = 0; CurveIndex < Uncompressed.Curves.Num(); CurveIndex++)
+	{
+		int32 UncompressedCursor = INDEX_NONE;
+		int32 CompressedCursor = INDEX_NONE;
+
+		for (int32 SampleIndex = 0; SampleIndex < SampleCount; SampleIndex++)
+		{
+			const float Time = FMath::Min(SampleIndex * SampleStep, Json->Duration);
+
+			const float Error = FMath::Abs(Compressed.Evaluate(CurveIndex, Time, CompressedCursor) - Uncompressed.Evaluate(CurveIndex, Time, UncompressedCursor));
+
+			if (Error > OutStats.MaxError)
+			{
+				OutStats.MaxError = Error;
+				OutStats.MaxErrorCurveId = Uncompressed.Curves[CurveIndex].Id;
+			}
+
+			ErrorSum += Error;
+			ErrorCount++;
+		}
+	}
+
+	OutStats.AverageError = ErrorCount > 0? (float)(ErrorSum / ErrorCount) : 0.0f;
+
+	OutStats.UncompressedSize = Json->SegmentBasePointIndices.Num() * sizeof(int32)
+		+ Json->SegmentTypes.Num() * sizeof(ECubismMotionSegmentType)
+		+ (Json->PointTimes.Num() + Json->PointValues.Num()) * sizeof(float);
+	OutStats.CompressedSize = OutSegmentData.GetSize();
+
+	return true;
+}
+
+int32 FCubismMotionCompression::RemoveLinearPoints(const UCubismMotion3Json* Json, const float Tolerance, FCubismMotionSegmentData& OutSegmentData)
+{
+	const TArray<ECubismMotionSegmentType>& SegmentTypes = Json->SegmentTypes;
+	const TArray<int32>& SegmentBasePointIndices = Json->SegmentBasePointIndices;
+	const TArray<float>& PointTimes = Json->PointTimes;
+	const TArray<float>& PointValues = Json->PointValues;
+
+	// check whether the points between the first and the last points lie on the line connecting them
+	auto IsOnLine = [&](const int32 FirstPointIndex, const int32 LastPointIndex)
+	{
+		const float Duration = PointTimes[LastPointIndex] - PointTimes[FirstPointIndex];
+
+		if (Duration <= 0.0f)
+		{
+			return false;
+		}
+
+		for (int32 PointIndex = FirstPointIndex + 1; PointIndex < LastPointIndex; PointIndex++)
+		{
+			const float T = (PointTimes[PointIndex] - PointTimes[FirstPointIndex]) / Duration;
+			const float Value = PointValues[FirstPointIndex] + ((PointValues[LastPointIndex] - PointValues[FirstPointIndex]) * T);
+
+			if (FMath::Abs(PointValues[PointIndex] - Value) > Tolerance)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	OutSegmentData = FCubismMotionSegmentData();
+
+	int32 RemovedPointCount = 0;
+
+	for (const FCubismMotionCurve& Curve : Json->Curves)
+	{
+		const int32 EndSegmentIndex = Curve.BaseSegmentIndex + Curve.SegmentCount;
+
+		OutSegmentData.CurveBaseSegmentIndices.Add(OutSegmentData.SegmentTypes.Num());
+
+		// the first point of the curve
+		const int32 FirstPointIndex = SegmentBasePointIndices[Curve.BaseSegmentIndex];
+
+		OutSegmentData.PointTimes.Add(PointTimes[FirstPointIndex]);
+		OutSegmentData.PointValues.Add(PointValues[FirstPointIndex]);
+
+		for (int32 SegmentIndex = Curve.BaseSegmentIndex; SegmentIndex < EndSegmentIndex;)
+		{
+			const int32 BasePointIndex = SegmentBasePointIndices[SegmentIndex];
+
+			// merge the following linear segments as long as the points between them lie on the line
+			int32 LastSegmentIndex = SegmentIndex;
+
+			if (Tolerance > 0.0f && SegmentTypes[SegmentIndex] == ECubismMotionSegmentType::Linear)
+			{
+				while (LastSegmentIndex + 1 < EndSegmentIndex
+					&& SegmentTypes[LastSegmentIndex + 1] == ECubismMotionSegmentType::Linear
+					&& IsOnLine(BasePointIndex, GetSegmentEndPointIndex(SegmentTypes, SegmentBasePointIndices, LastSegmentIndex + 1)))
+				{
+					LastSegmentIndex++;
+				}
+			}
+
+			OutSegmentData.SegmentTypes.Add(SegmentTypes[SegmentIndex]);
+			OutSegmentData.SegmentBasePointIndices.Add(OutSegmentData.PointTimes.Num() - 1);
+
+			if (LastSegmentIndex > SegmentIndex)
+			{
+				const int32 LastPointIndex = GetSegmentEndPointIndex(SegmentTypes, SegmentBasePointIndices, LastSegmentIndex);
+
+				OutSegmentData.PointTimes.Add(PointTimes[LastPointIndex]);
+				OutSegmentData.PointValues.Add(PointValues[LastPointIndex]);
+
+				RemovedPointCount += LastSegmentIndex - SegmentIndex;
+			}
+			else
+			{
+				const int32 LastPointIndex = GetSegmentEndPointIndex(SegmentTypes, SegmentBasePointIndices, SegmentIndex);
+
+				for (int32 PointIndex = BasePointIndex + 1; PointIndex <= LastPointIndex; PointIndex++)
+				{
+					OutSegmentData.PointTimes.Add(PointTimes[PointIndex]);
+					OutSegmentData.PointValues.Add(PointValues[PointIndex]);
+				}
+			}
+
+			SegmentIndex = LastSegmentIndex + 1;
+		}
+
+		OutSegmentData.CurveSegmentCounts.Add(OutSegmentData.SegmentTypes.Num() - OutSegmentData.CurveBaseSegmentIndices.Last());
+	}
+
+	return RemovedPointCount;
+}
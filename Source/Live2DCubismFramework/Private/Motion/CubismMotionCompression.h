@@ -0,0 +1,113 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Motion/CubismMotionData.h"
+
+/**
+ * A structure to hold the compressed segments and points of all curves of a motion.
+ */
+struct FCubismCompressedMotionSegmentData
+{
+	/**
+	 * The index of the first segment of each curve.
+	 */
+	TArray<int32> CurveBaseSegmentIndices;
+
+	/**
+	 * The number of the segments of each curve.
+	 */
+	TArray<int32> CurveSegmentCounts;
+
+	/**
+	 * The types of the segments.
+	 */
+	TArray<ECubismMotionSegmentType> SegmentTypes;
+
+	/**
+	 * The index of the first point of each segment.
+	 */
+	TArray<int32> SegmentBasePointIndices;
+
+	/**
+	 * The time of a step of the quantized times. (seconds)
+	 * If zero, the times are not quantized.
+	 */
+	float TimeStep = 0.0f;
+
+	/**
+	 * The times of the points in steps, if the times are quantized.
+	 */
+	TArray<uint16> QuantizedPointTimes;
+
+	/**
+	 * The times of the points, if the times are not quantized. (seconds)
+	 */
+	TArray<float> PointTimes;
+
+	/**
+	 * The minimum value of each curve, if the values are quantized.
+	 */
+	TArray<float> CurveMinimumValues;
+
+	/**
+	 * The value of a step of each curve, if the values are quantized.
+	 */
+	TArray<float> CurveValueSteps;
+
+	/**
+	 * The values of the points in steps from the minimum values of the curves, if the values are quantized.
+	 */
+	TArray<uint16> QuantizedPointValues;
+
+	/**
+	 * The values of the points, if the values are not quantized.
+	 */
+	TArray<float> PointValues;
+
+	/**
+	 * @brief The function to restore the segments and the points.
+	 * @param OutSegmentData The decompressed segments and points.
+	 */
+	void Decompress(FCubismMotionSegmentData& OutSegmentData) const;
+
+	/**
+	 * @brief The function to get the byte size of the compressed segments and points.
+	 * @return The byte size.
+	 */
+	int32 GetSize() const;
+
+	friend FArchive& operator<<(FArchive& Ar, FCubismCompressedMotionSegmentData& SegmentData);
+};
+
+/**
+ * A class to compress the curves of a motion.
+ */
+class FCubismMotionCompression
+{
+public:
+	/**
+	 * @brief The function to compress the segments of a json asset with its compression settings.
+	 * @param Json The json asset that contains the motion information.
+	 * @param OutSegmentData The compressed segments and points.
+	 * @param OutStats The sizes and the errors of the compression.
+	 * @return True if the segments are compressed, false if the json asset has no segments to compress.
+	 */
+	static bool Compress(const UCubismMotion3Json* Json, FCubismCompressedMotionSegmentData& OutSegmentData, FCubismMotionCompressionStats& OutStats);
+
+private:
+	/**
+	 * @brief The function to remove the points between the linear segments that lie on the line within the tolerance.
+	 * @param Json The json asset that contains the motion information.
+	 * @param Tolerance The maximum difference of the values allowed.
+	 * @param OutSegmentData The segments and points left.
+	 * @return The number of the points removed.
+	 */
+	static int32 RemoveLinearPoints(const UCubismMotion3Json* Json, const float Tolerance, FCubismMotionSegmentData& OutSegmentData);
+};
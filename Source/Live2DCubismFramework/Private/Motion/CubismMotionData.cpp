@@ -0,0 +1,581 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Motion/CubismMotionData.h"
+
+#include "Algo/StableSort.h"
+#include "CubismMath.h"
+#include "CubismLog.h"
+#include "CubismStats.h"
+
+namespace
+{
+	/**
+	 * The number of segments evaluated together.
+	 */
+	constexpr int32 CubismSegmentBatchSize = 4;
+
+	/**
+	 * A structure to evaluate the linear segments of several curves together.
+	 * The operations are the same as the scalar evaluation in the same order, so that the results are identical.
+	 */
+	struct FCubismLinearSegmentBatch
+	{
+		alignas(16) float Times0[CubismSegmentBatchSize];
+		alignas(16) float Times1[CubismSegmentBatchSize];
+		alignas(16) float Values0[CubismSegmentBatchSize];
+		alignas(16) float Values1[CubismSegmentBatchSize];
+		int32 CurveIndices[CubismSegmentBatchSize];
+		int32 Num = 0;
+
+		void Add(const int32 CurveIndex, const float* Times, const float* Values)
+		{
+			Times0[Num] = Times[0];
+			Times1[Num] = Times[1];
+			Values0[Num] = Values[0];
+			Values1[Num] = Values[1];
+			CurveIndices[Num] = CurveIndex;
+			Num++;
+		}
+
+		void Evaluate(const float Time, TArray<float>& OutValues)
+		{
+			if (Num == 0)
+			{
+				return;
+			}
+
+			// fill the unused lanes with a valid segment
+			for (int32 i = Num; i < CubismSegmentBatchSize; i++)
+			{
+				Times0[i] = 0.0f;
+				Times1[i] = 1.0f;
+				Values0[i] = 0.0f;
+				Values1[i] = 0.0f;
+			}
+
+			const VectorRegister4Float Zero = VectorZeroFloat();
+			const VectorRegister4Float V0 = VectorLoadAligned(Values0);
+			const VectorRegister4Float V1 = VectorLoadAligned(Values1);
+			const VectorRegister4Float T0 = VectorLoadAligned(Times0);
+
+			VectorRegister4Float T = VectorDivide(VectorSubtract(VectorSetFloat1(Time), T0), VectorSubtract(VectorLoadAligned(Times1), T0));
+			T = VectorSelect(VectorCompareLT(T, Zero), Zero, T);
+
+			alignas(16) float Results[CubismSegmentBatchSize];
+			VectorStoreAligned(VectorAdd(V0, VectorMultiply(VectorSubtract(V1, V0), T)), Results);
+
+			for (int32 i = 0; i < Num; i++)
+			{
+				OutValues[CurveIndices[i]] = Results[i];
+			}
+
+			Num = 0;
+		}
+	};
+
+	/**
+	 * A structure to evaluate the restricted Bezier segments of several curves together.
+	 * The operations are the same as the scalar evaluation in the same order, so that the results are identical.
+	 */
+	struct FCubismBezierSegmentBatch
+	{
+		alignas(16) float Times0[CubismSegmentBatchSize];
+		alignas(16) float Times3[CubismSegmentBatchSize];
+		alignas(16) float Values0[CubismSegmentBatchSize];
+		alignas(16) float Values1[CubismSegmentBatchSize];
+		alignas(16) float Values2[CubismSegmentBatchSize];
+		alignas(16) float Values3[CubismSegmentBatchSize];
+		int32 CurveIndices[CubismSegmentBatchSize];
+		int32 Num = 0;
+
+		void Add(const int32 CurveIndex, const float* Times, const float* Values)
+		{
+			Times0[Num] = Times[0];
+			Times3[Num] = Times[3];
+			Values0[Num] = Values[0];
+			Values1[Num] = Values[1];
+			Values2[Num] = Values[2];
+			Values3[Num] = Values[3];
+			CurveIndices[Num] = CurveIndex;
+			Num++;
+		}
+
+		void Evaluate(const float Time, TArray<float>& OutValues)
+		{
+			if (Num == 0)
+			{
+				return;
+			}
+
+			// fill the unused lanes with a valid segment
+			for (int32 i = Num; i < CubismSegmentBatchSize; i++)
+			{
+				Times0[i] = 0.0f;
+				Times3[i] = 1.0f;
+				Values0[i] = 0.0f;
+				Values1[i] = 0.0f;
+				Values2[i] = 0.0f;
+				Values3[i] = 0.0f;
+			}
+
+			const VectorRegister4Float Zero = VectorZeroFloat();
+			const VectorRegister4Float V0 = VectorLoadAligned(Values0);
+			const VectorRegister4Float V1 = VectorLoadAligned(Values1);
+			const VectorRegister4Float V2 = VectorLoadAligned(Values2);
+			const VectorRegister4Float V3 = VectorLoadAligned(Values3);
+			const VectorRegister4Float T0 = VectorLoadAligned(Times0);
+
+			VectorRegister4Float T = VectorDivide(VectorSubtract(VectorSetFloat1(Time), T0), VectorSubtract(VectorLoadAligned(Times3), T0));
+			T = VectorSelect(VectorCompareLT(T, Zero), Zero, T);
+
+			// de Casteljau's algorithm
+			const VectorRegister4Float P01 = VectorAdd(V0, VectorMultiply(VectorSubtract(V1, V0), T));
+			const VectorRegister4Float P12 = VectorAdd(V1, VectorMultiply(VectorSubtract(V2, V1), T));
+			const VectorRegister4Float P23 = VectorAdd(V2, VectorMultiply(VectorSubtract(V3, V2), T));
+
+			const VectorRegister4Float P012 = VectorAdd(P01, VectorMultiply(VectorSubtract(P12, P01), T));
+			const VectorRegister4Float P123 = VectorAdd(P12, VectorMultiply(VectorSubtract(P23, P12), T));
+
+			alignas(16) float Results[CubismSegmentBatchSize];
+			VectorStoreAligned(VectorAdd(P012, VectorMultiply(VectorSubtract(P123, P012), T)), Results);
+
+			for (int32 i = 0; i < Num; i++)
+			{
+				OutValues[CurveIndices[i]] = Results[i];
+			}
+
+			Num = 0;
+		}
+	};
+}
+
+FCubismMotionData::FCubismMotionData(const UCubismMotion3Json* Json)
+	: FCubismMotionData(Json, LoadSegmentData(Json))
+{
+}
+
+FCubismMotionData::FCubismMotionData(const UCubismMotion3Json* Json, FCubismMotionSegmentData&& SegmentData)
+{
+	check(Json);
+
+	Curves = Json->Curves;
+	CurveTable = Json->CurveTable;
+
+	bAreBeziersRestricted = Json->bAreBeziersRestricted;
+
+	// the events are dispatched by walking them in order of time
+	TArray<FCubismMotionEvent> Events = Json->Events;
+
+	Algo::StableSortBy(Events, &FCubismMotionEvent::Time);
+
+	EventTimes.Reserve(Events.Num());
+	EventValues.Reserve(Events.Num());
+
+	for (const FCubismMotionEvent& Event : Events)
+	{
+		EventTimes.Add(Event.Time);
+		EventValues.Add(FName(*Event.Value));
+	}
+
+	// the segments may be rearranged from those of the curves
+	if (SegmentData.CurveBaseSegmentIndices.Num() == Curves.Num() && SegmentData.CurveSegmentCounts.Num() == Curves.Num())
+	{
+		for (int32 CurveIndex = 0; CurveIndex < Curves.Num(); CurveIndex++)
+		{
+			Curves[CurveIndex].BaseSegmentIndex = SegmentData.CurveBaseSegmentIndices[CurveIndex];
+			Curves[CurveIndex].SegmentCount = SegmentData.CurveSegmentCounts[CurveIndex];
+		}
+	}
+
+	SegmentTypes = MoveTemp(SegmentData.SegmentTypes);
+	SegmentBasePointIndices = MoveTemp(SegmentData.SegmentBasePointIndices);
+	PointTimes = MoveTemp(SegmentData.PointTimes);
+	PointValues = MoveTemp(SegmentData.PointValues);
+
+	bUseSegments = ValidateSegments();
+
+	if (!bUseSegments)
+	{
+		SegmentTypes.Empty();
+		SegmentBasePointIndices.Empty();
+		PointTimes.Empty();
+		PointValues.Empty();
+
+		RichCurves.Init(nullptr, Curves.Num());
+	}
+
+	for (int32 CurveIndex = 0; CurveIndex < Curves.Num(); CurveIndex++)
+	{
+		const FCubismMotionCurve& Curve = Curves[CurveIndex];
+
+		if (!bUseSegments)
+		{
+			if (CurveTable)
+			{
+				RichCurves[CurveIndex] = CurveTable->FindRichCurve(*Curve.Id, Curve.Id, false);
+			}
+
+			if (!RichCurves[CurveIndex])
+			{
+				UE_LOG(LogCubism, Warning, TEXT("FCubismMotionData: Curve %s is not found in %s."), *Curve.Id, *Json->GetName());
+				continue;
+			}
+		}
+
+		switch (Curve.Target)
+		{
+			case ECubismMotionCurveTarget::Model:
+			{
+				// the assets imported by the older versions have no classification of the model curves
+				if (Curve.ModelCurve == ECubismMotionModelCurve::None)
+				{
+					Curves[CurveIndex].ModelCurve = FCubismMotionCurve::ClassifyModelCurve(Curve.Id);
+				}
+
+				ModelCurveIndices.Add(CurveIndex);
+				break;
+			}
+			case ECubismMotionCurveTarget::Parameter:
+			{
+				ParameterCurveIndices.Add(CurveIndex);
+				break;
+			}
+			case ECubismMotionCurveTarget::PartOpacity:
+			{
+				PartOpacityCurveIndices.Add(CurveIndex);
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+	}
+
+	PoseCacheFrameCount = 0;
+	PoseCacheFrameTime = 0.0f;
+
+	if (Json->bUsePoseCache)
+	{
+		BuildPoseCache(Json->Duration, Json->Fps);
+	}
+}
+
+void FCubismMotionData::BuildPoseCache(const float Duration, const float Fps)
+{
+	if (Duration <= 0.0f || Curves.Num() == 0)
+	{
+		return;
+	}
+
+	// the motions exported without the frame rate are sampled at the default one of the Editor
+	const float SampleFps = Fps > 0.0f? Fps : 30.0f;
+	const int32 FrameCount = FMath::CeilToInt(Duration * SampleFps) + 1;
+	const float FrameTime = Duration / (FrameCount - 1);
+
+	TArray<int32> Cursors;
+	Cursors.Init(INDEX_NONE, Curves.Num());
+
+	TArray<float> Values;
+
+	PoseCacheValues.SetNumUninitialized(FrameCount * Curves.Num());
+
+	for (int32 FrameIndex = 0; FrameIndex < FrameCount; FrameIndex++)
+	{
+		EvaluateAll(FrameIndex * FrameTime, Cursors, Values);
+
+		FMemory::Memcpy(&PoseCacheValues[FrameIndex * Curves.Num()], Values.GetData(), Curves.Num() * sizeof(float));
+	}
+
+	// enable the cache after sampling, as the sampling evaluates the curves
+	PoseCacheFrameCount = FrameCount;
+	PoseCacheFrameTime = FrameTime;
+}
+
+float FCubismMotionData::Evaluate(const int32 CurveIndex, const float Time) const
+{
+	int32 Cursor = INDEX_NONE;
+
+	return Evaluate(CurveIndex, Time, Cursor);
+}
+
+float FCubismMotionData::Evaluate(const int32 CurveIndex, const float Time, int32& Cursor) const
+{
+	if (!bUseSegments)
+	{
+		return RichCurves[CurveIndex]->Eval(Time, 0.0f);
+	}
+
+	if (FindSegment(CurveIndex, Time, Cursor))
+	{
+		return EvaluateSegment(Cursor, Time);
+	}
+
+	// the time is past the last point of the curve
+	return PointValues[GetSegmentEndPointIndex(Cursor - 1)];
+}
+
+void FCubismMotionData::EvaluateAll(const float Time, TArray<int32>& Cursors, TArray<float>& OutValues) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CubismMotionEvaluation);
+	INC_DWORD_STAT_BY(STAT_CubismCurvesEvaluated, Curves.Num());
+
+	check(Cursors.Num() == Curves.Num());
+
+	OutValues.SetNumUninitialized(Curves.Num(), false);
+
+	if (PoseCacheFrameCount > 0)
+	{
+		const float Position = FMath::Clamp(Time / PoseCacheFrameTime, 0.0f, (float)(PoseCacheFrameCount - 1));
+		const int32 FrameIndex = FMath::Min(FMath::FloorToInt(Position), PoseCacheFrameCount - 2);
+		const float Alpha = Position - FrameIndex;
+
+		const float* Values0 = &PoseCacheValues[FrameIndex * Curves.Num()];
+		const float* Values1 = Values0 + Curves.Num();
+
+		for (int32 CurveIndex = 0; CurveIndex < Curves.Num(); CurveIndex++)
+		{
+			OutValues[CurveIndex] = Values0[CurveIndex] + (Values1[CurveIndex] - Values0[CurveIndex]) * Alpha;
+		}
+
+		return;
+	}
+
+	if (!bUseSegments)
+	{
+		for (int32 CurveIndex = 0; CurveIndex < Curves.Num(); CurveIndex++)
+		{
+			OutValues[CurveIndex] = RichCurves[CurveIndex]? RichCurves[CurveIndex]->Eval(Time, 0.0f) : 0.0f;
+		}
+
+		return;
+	}
+
+	FCubismLinearSegmentBatch LinearBatch;
+	FCubismBezierSegmentBatch BezierBatch;
+
+	for (int32 CurveIndex = 0; CurveIndex < Curves.Num(); CurveIndex++)
+	{
+		int32& Cursor = Cursors[CurveIndex];
+
+		if (!FindSegment(CurveIndex, Time, Cursor))
+		{
+			OutValues[CurveIndex] = PointValues[GetSegmentEndPointIndex(Cursor - 1)];
+			continue;
+		}
+
+		const int32 BasePointIndex = SegmentBasePointIndices[Cursor];
+
+		switch (SegmentTypes[Cursor])
+		{
+			case ECubismMotionSegmentType::Linear:
+			{
+				LinearBatch.Add(CurveIndex, &PointTimes[BasePointIndex], &PointValues[BasePointIndex]);
+
+				if (LinearBatch.Num == CubismSegmentBatchSize)
+				{
+					LinearBatch.Evaluate(Time, OutValues);
+				}
+
+				break;
+			}
+			case ECubismMotionSegmentType::Bezier:
+			{
+				// the Cardano formula has too many branches to be vectorized
+				if (!bAreBeziersRestricted)
+				{
+					OutValues[CurveIndex] = EvaluateSegment(Cursor, Time);
+					break;
+				}
+
+				BezierBatch.Add(CurveIndex, &PointTimes[BasePointIndex], &PointValues[BasePointIndex]);
+
+				if (BezierBatch.Num == CubismSegmentBatchSize)
+				{
+					BezierBatch.Evaluate(Time, OutValues);
+				}
+
+				break;
+			}
+			default:
+			{
+				OutValues[CurveIndex] = EvaluateSegment(Cursor, Time);
+				break;
+			}
+		}
+	}
+
+	LinearBatch.Evaluate(Time, OutValues);
+	BezierBatch.Evaluate(Time, OutValues);
+}
+
+bool FCubismMotionData::FindSegment(const int32 CurveIndex, const float Time, int32& Cursor) const
+{
+	const FCubismMotionCurve& Curve = Curves[CurveIndex];
+	const int32 EndSegmentIndex = Curve.BaseSegmentIndex + Curve.SegmentCount;
+
+	// search from the first segment if the time went back, as on a loop or a seek
+	if (Cursor < Curve.BaseSegmentIndex || EndSegmentIndex < Cursor || (Curve.BaseSegmentIndex < Cursor && GetSegmentEndTime(Cursor - 1) > Time))
+	{
+		Cursor = Curve.BaseSegmentIndex;
+	}
+
+	// find the first segment ending after the time, which is usually the cached one or one of the next ones
+	const int32 LinearSearchEndIndex = FMath::Min(Cursor + LinearSearchCount, EndSegmentIndex);
+
+	while (Cursor < LinearSearchEndIndex && GetSegmentEndTime(Cursor) <= Time)
+	{
+		Cursor++;
+	}
+
+	// fall back to the binary search of the rest of the segments, as on a seek or a long tick
+	if (Cursor == LinearSearchEndIndex && Cursor < EndSegmentIndex && GetSegmentEndTime(Cursor) <= Time)
+	{
+		int32 LowIndex = Cursor + 1;
+		int32 HighIndex = EndSegmentIndex;
+
+		while (LowIndex < HighIndex)
+		{
+			const int32 MiddleIndex = LowIndex + (HighIndex - LowIndex) / 2;
+
+			if (GetSegmentEndTime(MiddleIndex) <= Time)
+			{
+				LowIndex = MiddleIndex + 1;
+			}
+			else
+			{
+				HighIndex = MiddleIndex;
+			}
+		}
+
+		Cursor = LowIndex;
+	}
+
+	return Cursor < EndSegmentIndex;
+}
+
+float FCubismMotionData::EvaluateSegment(const int32 SegmentIndex, const float Time) const
+{
+	const float* Times = &PointTimes[SegmentBasePointIndices[SegmentIndex]];
+	const float* Values = &PointValues[SegmentBasePointIndices[SegmentIndex]];
+
+	switch (SegmentTypes[SegmentIndex])
+	{
+		case ECubismMotionSegmentType::Linear:
+		{
+			float T = (Time - Times[0]) / (Times[1] - Times[0]);
+
+			if (T < 0.0f)
+			{
+				T = 0.0f;
+			}
+
+			return Values[0] + ((Values[1] - Values[0]) * T);
+		}
+		case ECubismMotionSegmentType::Bezier:
+		{
+			float T;
+
+			if (bAreBeziersRestricted)
+			{
+				T = (Time - Times[0]) / (Times[3] - Times[0]);
+
+				if (T < 0.0f)
+				{
+					T = 0.0f;
+				}
+			}
+			else
+			{
+				// solve the time of the curve for the parameter of the Bezier
+				const float X1 = Times[0];
+				const float X2 = Times[3];
+				const float CX1 = Times[1];
+				const float CX2 = Times[2];
+
+				const float A = X2 - 3.0f * CX2 + 3.0f * CX1 - X1;
+				const float B = 3.0f * CX2 - 6.0f * CX1 + 3.0f * X1;
+				const float C = 3.0f * CX1 - 3.0f * X1;
+				const float D = X1 - Time;
+
+				T = FCubismMath::CardanoAlgorithmForBezier(A, B, C, D);
+			}
+
+			// de Casteljau's algorithm
+			const float P01 = Values[0] + ((Values[1] - Values[0]) * T);
+			const float P12 = Values[1] + ((Values[2] - Values[1]) * T);
+			const float P23 = Values[2] + ((Values[3] - Values[2]) * T);
+
+			const float P012 = P01 + ((P12 - P01) * T);
+			const float P123 = P12 + ((P23 - P12) * T);
+
+			return P012 + ((P123 - P012) * T);
+		}
+		case ECubismMotionSegmentType::Stepped:
+		{
+			return Values[0];
+		}
+		case ECubismMotionSegmentType::InverseStepped:
+		{
+			return Values[1];
+		}
+		default:
+		{
+			ensure(false);
+			break;
+		}
+	}
+
+	return Values[0];
+}
+
+FCubismMotionSegmentData FCubismMotionData::LoadSegmentData(const UCubismMotion3Json* Json)
+{
+	check(Json);
+
+	FCubismMotionSegmentData SegmentData;
+
+	// the segments of the json asset are moved to the bulk data in cooked packages
+	if (Json->SegmentTypes.Num() > 0 || !Json->LoadSegmentBulkData(SegmentData))
+	{
+		SegmentData = FCubismMotionSegmentData();
+		SegmentData.SegmentTypes = Json->SegmentTypes;
+		SegmentData.SegmentBasePointIndices = Json->SegmentBasePointIndices;
+		SegmentData.PointTimes = Json->PointTimes;
+		SegmentData.PointValues = Json->PointValues;
+	}
+
+	return SegmentData;
+}
+
+bool FCubismMotionData::ValidateSegments() const
+{
+	if (SegmentTypes.Num() == 0 || SegmentTypes.Num() != SegmentBasePointIndices.Num() || PointTimes.Num() != PointValues.Num())
+	{
+		return false;
+	}
+
+	for (const FCubismMotionCurve& Curve : Curves)
+	{
+		if (Curve.SegmentCount <= 0 || Curve.BaseSegmentIndex < 0 || Curve.BaseSegmentIndex + Curve.SegmentCount > SegmentTypes.Num())
+		{
+			return false;
+		}
+	}
+
+	for (int32 SegmentIndex = 0; SegmentIndex < SegmentTypes.Num(); SegmentIndex++)
+	{
+		if (SegmentBasePointIndices[SegmentIndex] < 0 || GetSegmentEndPointIndex(SegmentIndex) >= PointTimes.Num())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -14,6 +14,7 @@
 #include "Physics/CubismPhysicsRig.h"
 #include "Physics/CubismPhysics3Json.h"
 #include "CubismMath.h"
+#include "CubismStats.h"
 #include "Live2DCubismCore.h"
 
 const float AirResistance = 5.0f;
@@ -331,6 +332,8 @@ void UCubismPhysicsComponent::TickComponent(float DeltaTime, ELevelTick TickType
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	SCOPE_CYCLE_COUNTER(STAT_CubismPhysicsUpdate);
+
 	CurrentRemainTime += DeltaTime;
 	if (CurrentRemainTime > MaxDeltaTime)
 	{
@@ -0,0 +1,234 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Rendering/CubismDrawableMeshResources.h"
+
+#include "Rendering/CubismDrawableSceneProxy.h"
+#include "MeshBatch.h"
+#include "PrimitiveSceneProxy.h"
+
+FCubismDynamicVertexBuffer::FCubismDynamicVertexBuffer(const uint32 InStride, const EPixelFormat InFormat)
+	: Stride(InStride)
+	, Format(InFormat)
+	, NumElements(0)
+{
+}
+
+void FCubismDynamicVertexBuffer::Write_RenderThread(FRHICommandListImmediate& RHICmdList, const void* Data)
+{
+	const uint32 Size = NumElements * Stride;
+
+	if (Size == 0)
+	{
+		return;
+	}
+
+	void* BufferData = RHICmdList.LockBuffer(VertexBufferRHI, 0, Size, RLM_WriteOnly);
+	FMemory::Memcpy(BufferData, Data, Size);
+	RHICmdList.UnlockBuffer(VertexBufferRHI);
+}
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+void FCubismDynamicVertexBuffer::InitRHI(FRHICommandListBase& RHICmdList)
+#else
+void FCubismDynamicVertexBuffer::InitRHI()
+#endif
+{
+	const uint32 Size = NumElements * Stride;
+
+	if (Size == 0)
+	{
+		return;
+	}
+
+	// the static usage makes the locks of every update stall or go through a staging copy on some RHIs
+	FRHIResourceCreateInfo CreateInfo(TEXT("FCubismDynamicVertexBuffer"));
+	const bool bShaderResource = RHISupportsManualVertexFetch(GMaxRHIShaderPlatform);
+	const EBufferUsageFlags Usage = bShaderResource? BUF_Dynamic | BUF_ShaderResource : BUF_Dynamic;
+	const uint32 ViewStride = GPixelFormats[Format].BlockBytes;
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+	VertexBufferRHI = RHICmdList.CreateVertexBuffer(Size, Usage, CreateInfo);
+
+	if (bShaderResource)
+	{
+		ShaderResourceViewRHI = RHICmdList.CreateShaderResourceView(VertexBufferRHI, ViewStride, Format);
+	}
+#else
+	VertexBufferRHI = RHICreateVertexBuffer(Size, Usage, CreateInfo);
+
+	if (bShaderResource)
+	{
+		ShaderResourceViewRHI = RHICreateShaderResourceView(VertexBufferRHI, ViewStride, Format);
+	}
+#endif
+}
+
+void FCubismDynamicVertexBuffer::ReleaseRHI()
+{
+	ShaderResourceViewRHI.SafeRelease();
+
+	FVertexBuffer::ReleaseRHI();
+}
+
+FCubismDrawableMeshResources::FCubismDrawableMeshResources(ERHIFeatureLevel::Type InFeatureLevel)
+	: bInitialized(false)
+	, NumVertices(0)
+	, NumIndices(0)
+	, Color(FColor::White)
+	, PositionVertexBuffer(sizeof(FVector3f), PF_R32_FLOAT)
+	, ColorVertexBuffer(sizeof(FColor), PF_R8G8B8A8)
+	, VertexFactory(InFeatureLevel, "FCubismDrawableMeshResources")
+{
+}
+
+FCubismDrawableMeshResources::~FCubismDrawableMeshResources()
+{
+	check(IsInRenderingThread());
+
+	Release();
+}
+
+void FCubismDrawableMeshResources::Update_RenderThread(FRHICommandListImmediate& RHICmdList, const FCubismDrawableDynamicMeshData& DynamicData)
+{
+	check(IsInRenderingThread());
+
+	// the indices and the UVs are only sent with the first data after the proxy is created
+	if (DynamicData.Indices.Num() > 0 && (!bInitialized || DynamicData.Positions.Num() != NumVertices || DynamicData.Indices.Num() != NumIndices))
+	{
+		Init_RenderThread(RHICmdList, DynamicData);
+
+		return;
+	}
+
+	if (!bInitialized)
+	{
+		return;
+	}
+
+	// the positions are only sent when they change
+	if (NumVertices > 0 && DynamicData.Positions.Num() == NumVertices)
+	{
+		PositionVertexBuffer.Write_RenderThread(RHICmdList, DynamicData.Positions.GetData());
+	}
+
+	if (DynamicData.Color != Color)
+	{
+		Color = DynamicData.Color;
+
+		ColorVertexBuffer.Write_RenderThread(RHICmdList, &Color);
+	}
+}
+
+void FCubismDrawableMeshResources::SetupMeshBatch(FMeshBatch& Mesh, const FPrimitiveSceneProxy* SceneProxy, FMaterialRenderProxy* MaterialProxy, const bool bTwoSided) const
+{
+	FMeshBatchElement& BatchElement = Mesh.Elements[0];
+	BatchElement.IndexBuffer = &IndexBuffer;
+	BatchElement.PrimitiveUniformBuffer = SceneProxy->GetUniformBuffer();
+	BatchElement.FirstIndex = 0;
+	BatchElement.NumPrimitives = NumIndices / 3;
+	BatchElement.MinVertexIndex = 0;
+	BatchElement.MaxVertexIndex = NumVertices - 1;
+
+	Mesh.VertexFactory = &VertexFactory;
+	Mesh.MaterialRenderProxy = MaterialProxy;
+	Mesh.ReverseCulling = SceneProxy->IsLocalToWorldDeterminantNegative();
+	Mesh.bDisableBackfaceCulling = bTwoSided;
+	Mesh.Type = PT_TriangleList;
+	Mesh.DepthPriorityGroup = SDPG_World;
+	Mesh.bCanApplyViewModeOverrides = false;
+}
+
+SIZE_T FCubismDrawableMeshResources::GetAllocatedSize() const
+{
+	return NumVertices * (sizeof(FVector3f) + 2 * sizeof(FPackedNormal) + sizeof(FVector2f))
+		+ NumIndices * sizeof(uint32)
+		+ sizeof(FColor);
+}
+
+void FCubismDrawableMeshResources::Init_RenderThread(FRHICommandListImmediate& RHICmdList, const FCubismDrawableDynamicMeshData& DynamicData)
+{
+	Release();
+
+	NumVertices = DynamicData.Positions.Num();
+	NumIndices = DynamicData.Indices.Num();
+	Color = DynamicData.Color;
+
+	if (NumVertices == 0 || NumIndices == 0)
+	{
+		return;
+	}
+
+	PositionVertexBuffer.SetNumElements(NumVertices);
+
+	// the tangents are constant as the drawables are flat, and only the first UV channel is used
+	StaticMeshVertexBuffer.SetUseFullPrecisionUVs(true);
+	StaticMeshVertexBuffer.Init(NumVertices, 1, false);
+
+	for (int32 i = 0; i < NumVertices; i++)
+	{
+		StaticMeshVertexBuffer.SetVertexTangents(i, FVector3f(1.0f, 0.0f, 0.0f), FVector3f(0.0f, 1.0f, 0.0f), FVector3f(0.0f, 0.0f, 1.0f));
+		StaticMeshVertexBuffer.SetVertexUV(i, 0, DynamicData.UVs[i]);
+	}
+
+	ColorVertexBuffer.SetNumElements(1);
+
+	IndexBuffer.Indices = DynamicData.Indices;
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+	PositionVertexBuffer.InitResource(RHICmdList);
+	StaticMeshVertexBuffer.InitResource(RHICmdList);
+	ColorVertexBuffer.InitResource(RHICmdList);
+	IndexBuffer.InitResource(RHICmdList);
+#else
+	PositionVertexBuffer.InitResource();
+	StaticMeshVertexBuffer.InitResource();
+	ColorVertexBuffer.InitResource();
+	IndexBuffer.InitResource();
+#endif
+
+	PositionVertexBuffer.Write_RenderThread(RHICmdList, DynamicData.Positions.GetData());
+	ColorVertexBuffer.Write_RenderThread(RHICmdList, &Color);
+
+	FLocalVertexFactory::FDataType VertexData;
+	VertexData.PositionComponent = FVertexStreamComponent(&PositionVertexBuffer, 0, sizeof(FVector3f), VET_Float3);
+	VertexData.PositionComponentSRV = PositionVertexBuffer.ShaderResourceViewRHI;
+	StaticMeshVertexBuffer.BindTangentVertexBuffer(&VertexFactory, VertexData);
+	StaticMeshVertexBuffer.BindPackedTexCoordVertexBuffer(&VertexFactory, VertexData);
+
+	// all vertices fetch the single color of the drawable
+	VertexData.ColorComponent = FVertexStreamComponent(&ColorVertexBuffer, 0, 0, VET_Color, EVertexStreamUsage::ManualFetch);
+	VertexData.ColorComponentsSRV = ColorVertexBuffer.ShaderResourceViewRHI;
+	VertexData.ColorIndexMask = 0;
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+	VertexFactory.SetData(RHICmdList, VertexData);
+	VertexFactory.InitResource(RHICmdList);
+#else
+	VertexFactory.SetData(VertexData);
+	VertexFactory.InitResource();
+#endif
+
+	bInitialized = true;
+}
+
+void FCubismDrawableMeshResources::Release()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+
+	VertexFactory.ReleaseResource();
+	IndexBuffer.ReleaseResource();
+	ColorVertexBuffer.ReleaseResource();
+	StaticMeshVertexBuffer.ReleaseResource();
+	PositionVertexBuffer.ReleaseResource();
+
+	bInitialized = false;
+}
@@ -0,0 +1,165 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "DynamicMeshBuilder.h"
+#include "LocalVertexFactory.h"
+#include "Rendering/StaticMeshVertexBuffer.h"
+
+struct FCubismDrawableDynamicMeshData;
+struct FMeshBatch;
+class FMaterialRenderProxy;
+class FPrimitiveSceneProxy;
+
+/**
+ * A vertex buffer created with the dynamic usage, to be rewritten by the CPU whenever its data changes.
+ */
+class FCubismDynamicVertexBuffer : public FVertexBuffer
+{
+public:
+	/**
+	 * @brief The constructor of the buffer.
+	 * @param InStride The size of an element in bytes.
+	 * @param InFormat The format to read the buffer through the shader resource view.
+	 */
+	FCubismDynamicVertexBuffer(const uint32 InStride, const EPixelFormat InFormat);
+
+	/**
+	 * @brief The function to set the number of the elements before the resource is initialized.
+	 * @param InNumElements The number of the elements.
+	 */
+	void SetNumElements(const int32 InNumElements)
+	{
+		NumElements = InNumElements;
+	}
+
+	/**
+	 * @brief The function to overwrite all elements of the buffer.
+	 * @param RHICmdList The command list to use.
+	 * @param Data The elements to write.
+	 */
+	void Write_RenderThread(FRHICommandListImmediate& RHICmdList, const void* Data);
+
+	//Begin FRenderResource Interface
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+	virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+#else
+	virtual void InitRHI() override;
+#endif
+	virtual void ReleaseRHI() override;
+	//End FRenderResource Interface
+
+	/** The shader resource view of the buffer for the manual vertex fetch. */
+	FShaderResourceViewRHIRef ShaderResourceViewRHI;
+
+private:
+	/** The size of an element in bytes. */
+	uint32 Stride;
+
+	/** The format to read the buffer through the shader resource view. */
+	EPixelFormat Format;
+
+	/** The number of the elements in the buffer. */
+	int32 NumElements;
+};
+
+/**
+ * The GPU resources to render a drawable with the local vertex factory.
+ * A vertex only consists of the position and the UV, and the color is a constant of the drawable.
+ * The indices and the UVs are uploaded once to static buffers,
+ * and the positions and the color are updated in place in dynamic buffers when they change.
+ */
+class FCubismDrawableMeshResources
+{
+public:
+	/**
+	 * @brief The constructor of the resources.
+	 * @param InFeatureLevel The feature level of the scene.
+	 */
+	FCubismDrawableMeshResources(ERHIFeatureLevel::Type InFeatureLevel);
+
+	/**
+	 * @brief The destructor of the resources.
+	 * @note The destructor must be called on the rendering thread.
+	 */
+	~FCubismDrawableMeshResources();
+
+	/**
+	 * @brief The function to upload the dynamic data of the drawable.
+	 * @param RHICmdList The command list to use.
+	 * @param DynamicData The dynamic data of the drawable.
+	 * @note The buffers are created only when the indices are sent and the number of vertices or indices changes.
+	 * @note The positions are left as they are if the dynamic data has no positions.
+	 */
+	void Update_RenderThread(FRHICommandListImmediate& RHICmdList, const FCubismDrawableDynamicMeshData& DynamicData);
+
+	/**
+	 * @brief The function to set up the mesh batch to render the drawable.
+	 * @param Mesh The mesh batch to set up.
+	 * @param SceneProxy The scene proxy that owns the resources.
+	 * @param MaterialProxy The material to render the drawable with.
+	 * @param bTwoSided The flag to disable the backface culling.
+	 */
+	void SetupMeshBatch(FMeshBatch& Mesh, const FPrimitiveSceneProxy* SceneProxy, FMaterialRenderProxy* MaterialProxy, const bool bTwoSided) const;
+
+	/**
+	 * @brief The function to check whether the resources can be rendered.
+	 * @return True if the resources are initialized and not empty, false otherwise.
+	 */
+	bool IsValid() const
+	{
+		return bInitialized && NumVertices > 0 && NumIndices > 0;
+	}
+
+	/**
+	 * @brief The function to get the size of the memory allocated by the resources.
+	 * @return The size of the allocated memory in bytes.
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/**
+	 * @brief The function to create the buffers and the vertex factory.
+	 * @param RHICmdList The command list to use.
+	 * @param DynamicData The dynamic data of the drawable.
+	 */
+	void Init_RenderThread(FRHICommandListImmediate& RHICmdList, const FCubismDrawableDynamicMeshData& DynamicData);
+
+	/**
+	 * @brief The function to release the buffers and the vertex factory.
+	 */
+	void Release();
+
+	/** The flag to indicate whether the buffers are created. */
+	bool bInitialized;
+
+	/** The number of vertices in the buffers. */
+	int32 NumVertices;
+
+	/** The number of indices in the buffer. */
+	int32 NumIndices;
+
+	/** The color stored in the color buffer. */
+	FColor Color;
+
+	/** The vertex positions updated with the drawable. */
+	FCubismDynamicVertexBuffer PositionVertexBuffer;
+
+	/** The constant tangents and the UVs of the vertices. */
+	FStaticMeshVertexBuffer StaticMeshVertexBuffer;
+
+	/** The single color shared by all vertices. */
+	FCubismDynamicVertexBuffer ColorVertexBuffer;
+
+	/** The vertex indices. */
+	FDynamicMeshIndexBuffer32 IndexBuffer;
+
+	/** The vertex factory that binds the buffers. */
+	FLocalVertexFactory VertexFactory;
+};
@@ -9,7 +9,7 @@
 #pragma once
 
 #include "PrimitiveSceneProxy.h"
-#include "DynamicMeshBuilder.h"
+#include "Rendering/CubismDrawableMeshResources.h"
 #include "Materials/Material.h"
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
 #include "Materials/MaterialRenderProxy.h"
@@ -17,15 +17,19 @@
 
 /**
  * Dynamic mesh data for a drawable.
+ * The indices and the UVs are only filled for the first data sent to a new proxy,
+ * and the positions are only filled when they change.
  */
 struct FCubismDrawableDynamicMeshData
 {
 	int32 Index;
+	int32 RenderOrder;
 	TArray<uint32> Indices;
 	FColor Color;
 	TArray<FVector3f> Positions;
 	TArray<FVector2f> UVs;
 	bool bTwoSided;
+	bool bVisible = true;
 };
 
 /**
@@ -38,6 +42,7 @@ public:
 		: FPrimitiveSceneProxy(Drawable)
 		, MaterialInstance(Drawable->GetMaterial(0))
 		, MaterialRelevance(Drawable->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+		, Resources(GetScene().GetFeatureLevel())
 	{
 	}
 
@@ -49,6 +54,25 @@ public:
 		return reinterpret_cast<size_t>(&UniquePointer);
 	}
 
+	/**
+	 * @brief The function to replace the dynamic data and upload it to the GPU.
+	 * @param RHICmdList The command list to use.
+	 * @param NewDynamicData The dynamic data of the drawable.
+	 */
+	void SetDynamicData_RenderThread(FRHICommandListImmediate& RHICmdList, FCubismDrawableDynamicMeshData&& NewDynamicData)
+	{
+		check(IsInRenderingThread());
+
+		DynamicData = MoveTemp(NewDynamicData);
+
+		Resources.Update_RenderThread(RHICmdList, DynamicData);
+
+		// the vertices live in the GPU buffers from now on
+		DynamicData.Indices.Empty();
+		DynamicData.Positions.Empty();
+		DynamicData.UVs.Empty();
+	}
+
 	virtual void GetDynamicMeshElements(
 		const TArray<const FSceneView*>& Views,
 		const FSceneViewFamily& ViewFamily,
@@ -56,6 +80,12 @@ public:
 		FMeshElementCollector& Collector
 	) const override
 	{
+		// invisible drawables emit no mesh batch
+		if (!DynamicData.bVisible || !Resources.IsValid())
+		{
+			return;
+		}
+
 		const bool bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
 
 		FMaterialRenderProxy* MaterialProxy = nullptr;
@@ -74,37 +104,19 @@ public:
 			MaterialProxy = MaterialInstance->GetRenderProxy();
 		}
 
-		TArray<FDynamicMeshVertex> Vertices;
-		for (int32 i = 0; i < DynamicData.Positions.Num(); i++)
-		{
-			FDynamicMeshVertex Vertex;
-
-			Vertex.SetTangents(FVector3f(1.0f,0.0f,0.0f), FVector3f(0.0f,1.0f,0.0f), FVector3f(0.0f,0.0f,1.0f));
-			Vertex.Color = DynamicData.Color;
-			Vertex.Position = DynamicData.Positions[i];
-			Vertex.TextureCoordinate[0] = DynamicData.UVs[i];
-
-			Vertices.Add(Vertex);
-		}
+		// the buffers are shared by all views, only the mesh batch is emitted per view
+		FMeshBatch SharedMesh;
+		Resources.SetupMeshBatch(SharedMesh, this, MaterialProxy, DynamicData.bTwoSided);
+		SharedMesh.bWireframe = bWireframe;
 
 		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
 		{
 			if (VisibilityMap & (1 << ViewIndex))
 			{
-				const FSceneView* View = Views[ViewIndex];
-
-				FDynamicMeshBuilder Builder(View->GetFeatureLevel());
-				Builder.AddVertices(Vertices);
-				Builder.AddTriangles(DynamicData.Indices);
-				Builder.GetMesh(
-					GetLocalToWorld(),
-					MaterialProxy,
-					SDPG_World,
-					DynamicData.bTwoSided,
-					false,
-					ViewIndex,
-					Collector
-				);
+				FMeshBatch& Mesh = Collector.AllocateMesh();
+				Mesh = SharedMesh;
+
+				Collector.AddMesh(ViewIndex, Mesh);
 			}
 		}
 	}
@@ -124,7 +136,7 @@ public:
 
 	virtual bool CanBeOccluded() const override { return !MaterialRelevance.bDisableDepthTest; }
 
-	virtual uint32 GetMemoryFootprint(void) const override { return(sizeof(*this) + GetAllocatedSize()); }
+	virtual uint32 GetMemoryFootprint(void) const override { return(sizeof(*this) + GetAllocatedSize() + Resources.GetAllocatedSize()); }
 
 public:
 	/** Dynamic mesh data for the drawable. */
@@ -136,4 +148,7 @@ private:
 
 	/** The material relevance for the drawable. */
 	FMaterialRelevance MaterialRelevance;
+
+	/** The GPU resources of the drawable. */
+	FCubismDrawableMeshResources Resources;
 };
@@ -0,0 +1,131 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Rendering/CubismMaterialPermutation.h"
+
+#include "CubismLog.h"
+#include "LocalVertexFactory.h"
+#include "Materials/Material.h"
+#include "UObject/StrongObjectPtr.h"
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+#include "PSOPrecache.h"
+#endif
+
+namespace
+{
+	/**
+	 * The materials kept loaded once they are precached.
+	 */
+	TArray<TStrongObjectPtr<UMaterialInterface>> PrecachedMaterials;
+}
+
+FString FCubismMaterialPermutation::GetMaterialName() const
+{
+	switch (BlendMode)
+	{
+		case ECubismDrawableBlendMode::Normal:
+		{
+			return !bMasked? TEXT("CustomUnlitNormal") : bInvertedMask? TEXT("CustomUnlitNormalMaskedInverted") : TEXT("CustomUnlitNormalMasked");
+		}
+		case ECubismDrawableBlendMode::Additive:
+		{
+			return !bMasked? TEXT("CustomUnlitAdditive") : bInvertedMask? TEXT("CustomUnlitAdditiveMaskedInverted") : TEXT("CustomUnlitAdditiveMasked");
+		}
+		case ECubismDrawableBlendMode::Multiplicative:
+		{
+			return !bMasked? TEXT("CustomUnlitMultiplicative") : bInvertedMask? TEXT("CustomUnlitMultiplicativeMaskedInverted") : TEXT("CustomUnlitMultiplicativeMasked");
+		}
+		default:
+		{
+			ensure(false);
+			break;
+		}
+	}
+
+	return FString();
+}
+
+UMaterialInterface* FCubismMaterialPermutation::LoadMaterial() const
+{
+	return Cast<UMaterial>(StaticLoadObject(UMaterial::StaticClass(), nullptr, *(TEXT("/Live2DCubismSDK/Materials") / GetMaterialName())));
+}
+
+TArray<FCubismMaterialPermutation> FCubismMaterialPermutation::GetAll()
+{
+	TArray<FCubismMaterialPermutation> Permutations;
+
+	for (const ECubismDrawableBlendMode BlendMode : {ECubismDrawableBlendMode::Normal, ECubismDrawableBlendMode::Additive, ECubismDrawableBlendMode::Multiplicative})
+	{
+		for (int32 MaskType = 0; MaskType < 3; MaskType++)
+		{
+			FCubismMaterialPermutation& Permutation = Permutations.AddDefaulted_GetRef();
+
+			Permutation.BlendMode = BlendMode;
+			Permutation.bMasked = MaskType > 0;
+			Permutation.bInvertedMask = MaskType > 1;
+		}
+	}
+
+	return Permutations;
+}
+
+void FCubismMaterialPrecache::Precache(const TArray<FCubismMaterialPermutation>& Permutations)
+{
+	check(IsInGameThread());
+
+	for (const FCubismMaterialPermutation& Permutation : Permutations)
+	{
+		UMaterialInterface* Material = Permutation.LoadMaterial();
+
+		if (!Material)
+		{
+			UE_LOG(LogCubism, Warning, TEXT("FCubismMaterialPrecache: Material %s is not found."), *Permutation.GetMaterialName());
+			continue;
+		}
+
+		const bool bAlreadyPrecached = PrecachedMaterials.ContainsByPredicate(
+			[Material](const TStrongObjectPtr<UMaterialInterface>& PrecachedMaterial)
+			{
+				return PrecachedMaterial.Get() == Material;
+			}
+		);
+
+		if (bAlreadyPrecached)
+		{
+			continue;
+		}
+
+		PrecachedMaterials.Add(TStrongObjectPtr<UMaterialInterface>(Material));
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+		if (IsComponentPSOPrecachingEnabled())
+		{
+			FPSOPrecacheVertexFactoryDataList VertexFactoryDataList;
+			VertexFactoryDataList.Add(FPSOPrecacheVertexFactoryData(&FLocalVertexFactory::StaticType));
+
+			FPSOPrecacheParams PrecachePSOParams;
+			PrecachePSOParams.bRenderInMainPass = true;
+
+			TArray<FMaterialPSOPrecacheRequestID> RequestIDs;
+			Material->PrecachePSOs(VertexFactoryDataList, PrecachePSOParams, EPSOPrecachePriority::High, RequestIDs);
+		}
+#endif
+
+		UE_LOG(LogCubism, Verbose, TEXT("FCubismMaterialPrecache: Material %s is precached."), *Permutation.GetMaterialName());
+	}
+}
+
+void FCubismMaterialPrecache::PrecacheAll()
+{
+	Precache(FCubismMaterialPermutation::GetAll());
+}
+
+void FCubismMaterialPrecache::Release()
+{
+	PrecachedMaterials.Empty();
+}
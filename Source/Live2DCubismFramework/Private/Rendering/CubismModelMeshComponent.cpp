@@ -0,0 +1,208 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Rendering/CubismModelMeshComponent.h"
+
+#include "Model/CubismDrawableComponent.h"
+#include "Model/CubismModelActor.h"
+#include "Model/CubismModelComponent.h"
+#include "Rendering/CubismModelSceneProxy.h"
+#include "Rendering/CubismRendererComponent.h"
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+#include "LocalVertexFactory.h"
+#include "PSOPrecache.h"
+#endif
+
+UCubismModelMeshComponent::UCubismModelMeshComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	bTickInEditor = true;
+	bTopologyDirty = true;
+}
+
+void UCubismModelMeshComponent::Setup(UCubismModelComponent* InModel)
+{
+	check(InModel);
+
+	Model = InModel;
+
+	MarkRenderStateDirty();
+}
+
+void UCubismModelMeshComponent::MarkDrawableDirty(const int32 DrawableIndex, const bool bVertexPositions)
+{
+	if (DrawableIndex < 0)
+	{
+		return;
+	}
+
+	if (DirtyDrawables.Num() <= DrawableIndex)
+	{
+		DirtyDrawables.Add(false, DrawableIndex + 1 - DirtyDrawables.Num());
+		DirtyVertexPositions.Add(false, DrawableIndex + 1 - DirtyVertexPositions.Num());
+	}
+
+	DirtyDrawables[DrawableIndex] = true;
+	DirtyVertexPositions[DrawableIndex] = DirtyVertexPositions[DrawableIndex] || bVertexPositions;
+
+	MarkRenderDynamicDataDirty();
+}
+
+//Begin USceneComponent Interface
+FBoxSphereBounds UCubismModelMeshComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	FBox Box(ForceInit);
+
+	if (Model)
+	{
+		for (const TObjectPtr<UCubismDrawableComponent>& Drawable : Model->Drawables)
+		{
+			Box += Drawable->CalcBounds(FTransform::Identity).GetBox();
+		}
+	}
+
+	return FBoxSphereBounds(Box).TransformBy(LocalToWorld);
+}
+//End USceneComponent Interface
+
+//Begin UMeshComponent Interface
+int32 UCubismModelMeshComponent::GetNumMaterials() const
+{
+	return Model ? Model->Drawables.Num() : 0;
+}
+
+UMaterialInterface* UCubismModelMeshComponent::GetMaterial(int32 ElementIndex) const
+{
+	if (!Model || !Model->Drawables.IsValidIndex(ElementIndex))
+	{
+		return nullptr;
+	}
+
+	return Model->Drawables[ElementIndex]->GetMaterial(0);
+}
+
+void UCubismModelMeshComponent::GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials) const
+{
+	for (int32 ElementIndex = 0; ElementIndex < GetNumMaterials(); ElementIndex++)
+	{
+		if (UMaterialInterface* Material = GetMaterial(ElementIndex))
+		{
+			OutMaterials.Add(Material);
+		}
+	}
+}
+//End UMeshComponent Interface
+
+// UObject interface
+void UCubismModelMeshComponent::PostLoad()
+{
+	Super::PostLoad();
+
+	const ACubismModel* Owner = Cast<ACubismModel>(GetOwner());
+
+	Setup(Owner->Model);
+}
+// End of UObject interface
+
+// UActorComponent interface
+void UCubismModelMeshComponent::OnComponentCreated()
+{
+	Super::OnComponentCreated();
+
+	const ACubismModel* Owner = Cast<ACubismModel>(GetOwner());
+
+	Setup(Owner->Model);
+}
+// End of UActorComponent interface
+
+//Begin UPrimitiveComponent Interface
+FPrimitiveSceneProxy* UCubismModelMeshComponent::CreateSceneProxy()
+{
+	if (!Model)
+	{
+		return nullptr;
+	}
+
+	return new FCubismModelSceneProxy(this);
+}
+//End UPrimitiveComponent Interface
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+void UCubismModelMeshComponent::CollectPSOPrecacheData(const FPSOPrecacheParams& BasePrecachePSOParams, FMaterialInterfacePSOPrecacheParamsList& OutParams)
+{
+	for (int32 ElementIndex = 0; ElementIndex < GetNumMaterials(); ElementIndex++)
+	{
+		FMaterialInterfacePSOPrecacheParams& ComponentParams = OutParams[OutParams.AddDefaulted()];
+		ComponentParams.MaterialInterface = GetMaterial(ElementIndex);
+		ComponentParams.VertexFactoryDataList.Add(FPSOPrecacheVertexFactoryData(&FLocalVertexFactory::StaticType));
+		ComponentParams.PSOPrecacheParams = BasePrecachePSOParams;
+	}
+}
+#endif
+
+void UCubismModelMeshComponent::CreateRenderState_Concurrent(FRegisterComponentContext* Context)
+{
+	Super::CreateRenderState_Concurrent(Context);
+
+	// the new proxy needs the current vertices of all drawables even if they do not change
+	bTopologyDirty = true;
+
+	SendRenderDynamicData_Concurrent();
+}
+
+void UCubismModelMeshComponent::SendRenderDynamicData_Concurrent()
+{
+	Super::SendRenderDynamicData_Concurrent();
+
+	FCubismModelSceneProxy* ModelProxy = static_cast<FCubismModelSceneProxy*>(SceneProxy);
+
+	if (!ModelProxy)
+	{
+		return;
+	}
+
+	// only the drawables that changed since the last update are sent
+	FCubismModelDynamicMeshData NewDynamicData;
+
+	for (const TObjectPtr<UCubismDrawableComponent>& Drawable : Model->Drawables)
+	{
+		const int32 DrawableIndex = Drawable->Index;
+		const bool bDirty = DirtyDrawables.IsValidIndex(DrawableIndex) && DirtyDrawables[DrawableIndex];
+
+		if (!bTopologyDirty && !bDirty)
+		{
+			continue;
+		}
+
+		const bool bVisible = Drawable->IsVisible();
+		const bool bVertexPositions = bDirty && DirtyVertexPositions[DrawableIndex] && bVisible;
+
+		FCubismDrawableDynamicMeshData& DrawableData = NewDynamicData.Drawables.AddDefaulted_GetRef();
+
+		Drawable->GetDynamicMeshData(DrawableData, bVertexPositions, bTopologyDirty);
+
+		DrawableData.bVisible &= bVisible;
+		DrawableData.RenderOrder = Model->Renderer? Model->Renderer->CalcDrawableRenderOrder(Drawable) : Drawable->RenderOrder;
+	}
+
+	DirtyDrawables.Init(false, Model->Drawables.Num());
+	DirtyVertexPositions.Init(false, Model->Drawables.Num());
+	bTopologyDirty = false;
+
+	if (NewDynamicData.Drawables.Num() == 0)
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(ModelUpdateDynamicData)(
+		[ModelProxy, NewDynamicData = MoveTemp(NewDynamicData)](FRHICommandListImmediate& RHICommandList) mutable
+		{
+			ModelProxy->SetDynamicData_RenderThread(RHICommandList, MoveTemp(NewDynamicData));
+		}
+	);
+}
@@ -0,0 +1,224 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Rendering/CubismDrawableSceneProxy.h"
+#include "Components/MeshComponent.h"
+
+/**
+ * Dynamic mesh data for the drawables of a model that changed since the last update.
+ */
+struct FCubismModelDynamicMeshData
+{
+	TArray<FCubismDrawableDynamicMeshData> Drawables;
+};
+
+/**
+ * A representation of a UCubismModelMeshComponent or a UCubismVertexAnimationComponent on the rendering thread.
+ * The drawables are emitted in the render order of the model.
+ * The materials of the component are indexed by the drawable index.
+ * The translucent mesh batches of a primitive share its distance and sort priority,
+ * so each drawable is given its position in the render order as the mesh id to keep the order in the translucency sort.
+ */
+class FCubismModelSceneProxy : public FPrimitiveSceneProxy
+{
+public:
+	FCubismModelSceneProxy(const UMeshComponent* ModelMesh)
+		: FPrimitiveSceneProxy(ModelMesh)
+		, MaterialRelevance(ModelMesh->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+	{
+		MaterialInstances.Reserve(ModelMesh->GetNumMaterials());
+
+		for (int32 ElementIndex = 0; ElementIndex < ModelMesh->GetNumMaterials(); ElementIndex++)
+		{
+			MaterialInstances.Add(ModelMesh->GetMaterial(ElementIndex));
+		}
+
+		Resources.SetNum(MaterialInstances.Num());
+
+		// nothing is rendered until the drawables are sent
+		Drawables.SetNum(MaterialInstances.Num());
+		SortedDrawables.Reserve(MaterialInstances.Num());
+
+		for (int32 DrawableIndex = 0; DrawableIndex < Drawables.Num(); DrawableIndex++)
+		{
+			FCubismDrawableDynamicMeshData& DrawableData = Drawables[DrawableIndex];
+			DrawableData.Index = DrawableIndex;
+			DrawableData.RenderOrder = DrawableIndex;
+			DrawableData.Color = FColor::White;
+			DrawableData.bTwoSided = false;
+			DrawableData.bVisible = false;
+
+			SortedDrawables.Add(DrawableIndex);
+		}
+	}
+
+	virtual ~FCubismModelSceneProxy() { }
+
+	SIZE_T GetTypeHash() const override
+	{
+		static size_t UniquePointer;
+		return reinterpret_cast<size_t>(&UniquePointer);
+	}
+
+	/**
+	 * @brief The function to apply the changed drawables, upload their vertices to the GPU and sort the drawables in the render order.
+	 * @param RHICmdList The command list to use.
+	 * @param NewDynamicData The dynamic data of the drawables that changed.
+	 */
+	void SetDynamicData_RenderThread(FRHICommandListImmediate& RHICmdList, FCubismModelDynamicMeshData&& NewDynamicData)
+	{
+		check(IsInRenderingThread());
+
+		bool bRenderOrderChanged = false;
+
+		for (FCubismDrawableDynamicMeshData& DrawableData : NewDynamicData.Drawables)
+		{
+			if (!Drawables.IsValidIndex(DrawableData.Index))
+			{
+				continue;
+			}
+
+			TUniquePtr<FCubismDrawableMeshResources>& DrawableResources = Resources[DrawableData.Index];
+
+			if (!DrawableResources && DrawableData.Indices.Num() > 0)
+			{
+				DrawableResources = MakeUnique<FCubismDrawableMeshResources>(GetScene().GetFeatureLevel());
+			}
+
+			if (DrawableResources)
+			{
+				DrawableResources->Update_RenderThread(RHICmdList, DrawableData);
+			}
+
+			bRenderOrderChanged |= DrawableData.RenderOrder != Drawables[DrawableData.Index].RenderOrder;
+
+			// the vertices live in the GPU buffers from now on
+			DrawableData.Indices.Empty();
+			DrawableData.Positions.Empty();
+			DrawableData.UVs.Empty();
+
+			Drawables[DrawableData.Index] = MoveTemp(DrawableData);
+		}
+
+		if (bRenderOrderChanged)
+		{
+			SortedDrawables.Sort(
+				[this](const int32 A, const int32 B)
+				{
+					const int32 RenderOrderA = Drawables[A].RenderOrder;
+					const int32 RenderOrderB = Drawables[B].RenderOrder;
+
+					return RenderOrderA != RenderOrderB? RenderOrderA < RenderOrderB : A < B;
+				}
+			);
+		}
+	}
+
+	virtual void GetDynamicMeshElements(
+		const TArray<const FSceneView*>& Views,
+		const FSceneViewFamily& ViewFamily,
+		uint32 VisibilityMap,
+		FMeshElementCollector& Collector
+	) const override
+	{
+		const bool bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
+
+		FMaterialRenderProxy* WireframeMaterialProxy = nullptr;
+		if (bWireframe)
+		{
+			FColoredMaterialRenderProxy* WireframeMaterialInstance = new FColoredMaterialRenderProxy(
+				GEngine->WireframeMaterial->GetRenderProxy(),
+				FLinearColor(0.0f, 0.5f, 1.0f)
+			);
+
+			Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
+			WireframeMaterialProxy = WireframeMaterialInstance;
+		}
+
+		// the drawables are already sorted, and the translucency sort only keeps their order through the mesh id
+		for (int32 SortIndex = 0; SortIndex < SortedDrawables.Num(); SortIndex++)
+		{
+			const FCubismDrawableDynamicMeshData& DrawableData = Drawables[SortedDrawables[SortIndex]];
+
+			if (!DrawableData.bVisible || !MaterialInstances.IsValidIndex(DrawableData.Index) || !MaterialInstances[DrawableData.Index])
+			{
+				continue;
+			}
+
+			const TUniquePtr<FCubismDrawableMeshResources>& DrawableResources = Resources[DrawableData.Index];
+
+			if (!DrawableResources || !DrawableResources->IsValid())
+			{
+				continue;
+			}
+
+			FMaterialRenderProxy* MaterialProxy = bWireframe? WireframeMaterialProxy : MaterialInstances[DrawableData.Index]->GetRenderProxy();
+
+			// the buffers are shared by all views, only the mesh batch is emitted per view
+			FMeshBatch SharedMesh;
+			DrawableResources->SetupMeshBatch(SharedMesh, this, MaterialProxy, DrawableData.bTwoSided);
+			SharedMesh.bWireframe = bWireframe;
+			SharedMesh.MeshIdInPrimitive = static_cast<uint16>(SortIndex);
+
+			for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+			{
+				if (VisibilityMap & (1 << ViewIndex))
+				{
+					FMeshBatch& Mesh = Collector.AllocateMesh();
+					Mesh = SharedMesh;
+
+					Collector.AddMesh(ViewIndex, Mesh);
+				}
+			}
+		}
+	}
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+	{
+		FPrimitiveViewRelevance Result;
+		Result.bDrawRelevance = IsShown(View);
+		Result.bShadowRelevance = IsShadowCast(View);
+		Result.bDynamicRelevance = true;
+		Result.bRenderInMainPass = ShouldRenderInMainPass();
+		Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+		Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+		MaterialRelevance.SetPrimitiveViewRelevance(Result);
+		return Result;
+	}
+
+	virtual bool CanBeOccluded() const override { return !MaterialRelevance.bDisableDepthTest; }
+
+	virtual uint32 GetMemoryFootprint(void) const override
+	{
+		SIZE_T ResourcesSize = 0;
+		for (const TUniquePtr<FCubismDrawableMeshResources>& DrawableResources : Resources)
+		{
+			ResourcesSize += DrawableResources? DrawableResources->GetAllocatedSize() : 0;
+		}
+
+		return(sizeof(*this) + GetAllocatedSize() + ResourcesSize);
+	}
+
+private:
+	/** The last dynamic mesh data of the drawables without the vertices, indexed by the drawable index. */
+	TArray<FCubismDrawableDynamicMeshData> Drawables;
+
+	/** The drawable indices sorted in the render order. */
+	TArray<int32> SortedDrawables;
+
+	/** The material instances to use for rendering, indexed by the drawable index. */
+	TArray<UMaterialInterface*> MaterialInstances;
+
+	/** The material relevance for the model. */
+	FMaterialRelevance MaterialRelevance;
+
+	/** The GPU resources of the drawables, indexed by the drawable index. */
+	TArray<TUniquePtr<FCubismDrawableMeshResources>> Resources;
+};
@@ -15,6 +15,7 @@
 #include "Rendering/CubismMaskTexture.h"
 #include "Rendering/CubismMaskTextureComponent.h"
 #include "Rendering/CubismMaskJunction.h"
+#include "Rendering/CubismModelMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Kismet/GameplayStatics.h"
@@ -93,32 +94,44 @@ void UCubismRendererComponent::Setup(UCubismModelComponent* InModel)
 	AddTickPrerequisiteComponent(MaskTexture->MaskTextureComponent); // must render after mask texture updated
 }
 
+void UCubismRendererComponent::SetBatchDrawables(const bool bInBatchDrawables)
+{
+	bBatchDrawables = bInBatchDrawables;
+
+	if (Model)
+	{
+		ApplyRenderOrder();
+	}
+}
+
 void UCubismRendererComponent::ApplyRenderOrder()
 {
-	for (const TObjectPtr<UCubismDrawableComponent>& Drawable : Model->Drawables)
+	// the model mesh only exists while the drawables are batched
+	if (bBatchDrawables)
 	{
-		int32 NewRenderOrder = Drawable->RenderOrder + Drawable->RenderOrderOffset;
+		CreateModelMesh();
+	}
+
+	const bool bBatched = bBatchDrawables && ModelMesh;
 
-		switch (SortingOrder)
+	for (const TObjectPtr<UCubismDrawableComponent>& Drawable : Model->Drawables)
+	{
+		if (bBatched)
 		{
-			case ECubismRendererSortingOrder::FrontToBack:
-			{
-				break;
-			}
-			case ECubismRendererSortingOrder::BackToFront:
-			{
-				NewRenderOrder = Model->GetDrawableCount() - NewRenderOrder - 1;
+			// the model mesh sorts the drawables by itself
+			Drawable->SetModelMesh(ModelMesh);
+			Drawable->SetTranslucentSortPriority(0);
+			Drawable->SetRelativeLocation(FVector(0.0f, 0.0f, 0.0f));
 
-				break;
-			}
-			default:
-			{
-				ensure(false);
-				break;
-			}
+			// the model mesh was not updated while the drawables rendered themselves
+			ModelMesh->MarkDrawableDirty(Drawable->Index, true);
+
+			continue;
 		}
 
-		NewRenderOrder += RenderOrder;
+		Drawable->SetModelMesh(nullptr);
+
+		const int32 NewRenderOrder = CalcDrawableRenderOrder(Drawable) + RenderOrder;
 
 		if (bZSort)
 		{
@@ -131,6 +144,74 @@ void UCubismRendererComponent::ApplyRenderOrder()
 			Drawable->SetRelativeLocation(FVector(0.0f, 0.0f, 0.0f));
 		}
 	}
+
+	if (bBatched)
+	{
+		ModelMesh->SetTranslucentSortPriority(RenderOrder);
+	}
+	else if (IsRegistered())
+	{
+		DestroyModelMesh();
+	}
+}
+
+int32 UCubismRendererComponent::CalcDrawableRenderOrder(const UCubismDrawableComponent* Drawable) const
+{
+	int32 NewRenderOrder = Drawable->RenderOrder + Drawable->RenderOrderOffset;
+
+	switch (SortingOrder)
+	{
+		case ECubismRendererSortingOrder::FrontToBack:
+		{
+			break;
+		}
+		case ECubismRendererSortingOrder::BackToFront:
+		{
+			NewRenderOrder = Model->GetDrawableCount() - NewRenderOrder - 1;
+
+			break;
+		}
+		default:
+		{
+			ensure(false);
+			break;
+		}
+	}
+
+	return NewRenderOrder;
+}
+
+void UCubismRendererComponent::CreateModelMesh()
+{
+	// the component can not be registered before the renderer is, so it is created again in OnRegister()
+	if (ModelMesh || !IsRegistered())
+	{
+		return;
+	}
+
+	// the mesh destroyed by the last switch may still hold the name
+	const FName MeshName = MakeUniqueObjectName(Model, UCubismModelMeshComponent::StaticClass(), TEXT("ModelMesh"));
+
+	ModelMesh = NewObject<UCubismModelMeshComponent>(Model, MeshName, RF_Transactional);
+
+	ModelMesh->Setup(Model);
+	ModelMesh->RegisterComponent();
+	GetOwner()->AddInstanceComponent(ModelMesh);
+	ModelMesh->AttachToComponent(Model, FAttachmentTransformRules::KeepRelativeTransform);
+}
+
+void UCubismRendererComponent::DestroyModelMesh()
+{
+	if (!ModelMesh)
+	{
+		return;
+	}
+
+	ModelMesh->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+	GetOwner()->RemoveInstanceComponent(ModelMesh);
+	ModelMesh->UnregisterComponent();
+	ModelMesh->DestroyComponent();
+	ModelMesh = nullptr;
 }
 
 // UObject interface
@@ -162,6 +243,7 @@ void UCubismRendererComponent::PostEditChangeProperty(FPropertyChangedEvent& Pro
 
 	if (
 		PropertyName == GET_MEMBER_NAME_CHECKED(UCubismRendererComponent, SortingOrder) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UCubismRendererComponent, bBatchDrawables) ||
 		PropertyName == GET_MEMBER_NAME_CHECKED(UCubismRendererComponent, bZSort) ||
 		PropertyName == GET_MEMBER_NAME_CHECKED(UCubismRendererComponent, RenderOrder) ||
 		PropertyName == GET_MEMBER_NAME_CHECKED(UCubismRendererComponent, Epsilon))
@@ -203,9 +285,22 @@ void UCubismRendererComponent::OnComponentCreated()
 
 	MaskTexture->MaskTextureComponent->AddModel(Owner);
 
+	Model = Owner->Model;
+
 	Setup(Owner->Model);
 }
 
+void UCubismRendererComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// the model mesh of a batched model is created once the renderer is registered
+	if (Model)
+	{
+		ApplyRenderOrder();
+	}
+}
+
 void UCubismRendererComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 {
 	if (MaskTexture)
@@ -215,6 +310,8 @@ void UCubismRendererComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
 		MaskTexture->MaskTextureComponent->RemoveModel(Owner);
 	}
 
+	DestroyModelMesh();
+
 	if (Model->Renderer == this)
 	{
 		Model->Renderer = nullptr;
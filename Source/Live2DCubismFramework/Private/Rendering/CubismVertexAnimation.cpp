@@ -0,0 +1,55 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Rendering/CubismVertexAnimation.h"
+
+FVector3f UCubismVertexAnimation::GetVertexPosition(const int32 FrameIndex, const int32 DrawableIndex, const int32 VertexIndex) const
+{
+	const FCubismVertexAnimationDrawable& Drawable = Drawables[DrawableIndex];
+
+	const int32 PositionIndex = 2 * (FrameIndex * TotalVertexCount + Drawable.BaseVertexIndex + VertexIndex);
+
+	// align the model on the y-z plane
+	return FVector3f(
+		0.0f,
+		Drawable.PositionMinimum.X + Drawable.PositionStep.X * QuantizedPositions[PositionIndex],
+		Drawable.PositionMinimum.Y + Drawable.PositionStep.Y * QuantizedPositions[PositionIndex + 1]
+	);
+}
+
+void UCubismVertexAnimation::FindFrames(const float Time, int32& OutFrameIndex, int32& OutNextFrameIndex, float& OutAlpha) const
+{
+	check(FrameCount > 0);
+
+	const float Frame = FMath::Clamp(Time * Fps, 0.0f, (float)(FrameCount - 1));
+
+	OutFrameIndex = FMath::Min(FMath::FloorToInt32(Frame), FrameCount - 1);
+	OutNextFrameIndex = FMath::Min(OutFrameIndex + 1, FrameCount - 1);
+	OutAlpha = Frame - OutFrameIndex;
+}
+
+FBox UCubismVertexAnimation::GetBounds() const
+{
+	FBox Box(ForceInit);
+
+	for (const FCubismVertexAnimationDrawable& Drawable : Drawables)
+	{
+		if (Drawable.VertexCount == 0)
+		{
+			continue;
+		}
+
+		// the quantized positions span the whole range of the drawable
+		const FVector2f Maximum = Drawable.PositionMinimum + Drawable.PositionStep * (float)MAX_uint16;
+
+		Box += FVector(0.0f, Drawable.PositionMinimum.X, Drawable.PositionMinimum.Y);
+		Box += FVector(0.0f, Maximum.X, Maximum.Y);
+	}
+
+	return Box;
+}
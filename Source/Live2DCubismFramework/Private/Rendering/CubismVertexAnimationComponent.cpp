@@ -0,0 +1,298 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "Rendering/CubismVertexAnimationComponent.h"
+
+#include "Rendering/CubismMaterialPermutation.h"
+#include "Rendering/CubismModelSceneProxy.h"
+#include "Rendering/CubismVertexAnimation.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+UCubismVertexAnimationComponent::UCubismVertexAnimationComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_DuringPhysics;
+	bTickInEditor = true;
+	bTopologyDirty = true;
+}
+
+void UCubismVertexAnimationComponent::SetAnimation(UCubismVertexAnimation* InAnimation)
+{
+	Animation = InAnimation;
+
+	CreateMaterialInstances();
+
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
+void UCubismVertexAnimationComponent::SetRenderMaskedDrawables(const bool bInRenderMaskedDrawables)
+{
+	bRenderMaskedDrawables = bInRenderMaskedDrawables;
+
+	MarkRenderDynamicDataDirty();
+}
+
+void UCubismVertexAnimationComponent::CreateMaterialInstances()
+{
+	MaterialInstances.Empty();
+	Opacities.Empty();
+
+	if (!Animation)
+	{
+		return;
+	}
+
+	MaterialInstances.Reserve(Animation->Drawables.Num());
+	Opacities.Init(-1.0f, Animation->Drawables.Num());
+
+	for (const FCubismVertexAnimationDrawable& Drawable : Animation->Drawables)
+	{
+		// the masks are not baked, so the masked drawables are rendered unmasked if they are rendered at all
+		FCubismMaterialPermutation Permutation;
+		Permutation.BlendMode = Drawable.BlendMode;
+
+		const FString MaterialName = Permutation.GetMaterialName();
+
+		UMaterialInstanceDynamic* MaterialInstance = UMaterialInstanceDynamic::Create(Permutation.LoadMaterial(), this, *MaterialName);
+
+		if (MaterialInstance)
+		{
+			MaterialInstance->SetTextureParameterValue("MainTexture", Drawable.Texture);
+			MaterialInstance->SetVectorParameterValue("MultiplyColor", Drawable.MultiplyColor);
+			MaterialInstance->SetVectorParameterValue("ScreenColor", Drawable.ScreenColor);
+		}
+
+		MaterialInstances.Add(MaterialInstance);
+	}
+
+	UpdateOpacities();
+}
+
+void UCubismVertexAnimationComponent::UpdateOpacities()
+{
+	if (!Animation || Animation->FrameCount == 0 || Opacities.Num() != Animation->Drawables.Num())
+	{
+		return;
+	}
+
+	int32 FrameIndex;
+	int32 NextFrameIndex;
+	float Alpha;
+	Animation->FindFrames(Time, FrameIndex, NextFrameIndex, Alpha);
+
+	for (int32 DrawableIndex = 0; DrawableIndex < Opacities.Num(); DrawableIndex++)
+	{
+		const float Opacity = FMath::Lerp(Animation->GetOpacity(FrameIndex, DrawableIndex), Animation->GetOpacity(NextFrameIndex, DrawableIndex), Alpha);
+
+		if (Opacity == Opacities[DrawableIndex])
+		{
+			continue;
+		}
+
+		Opacities[DrawableIndex] = Opacity;
+
+		if (UMaterialInstanceDynamic* MaterialInstance = MaterialInstances[DrawableIndex])
+		{
+			MaterialInstance->SetVectorParameterValue("BaseColor", FLinearColor(1.0f, 1.0f, 1.0f, Opacity));
+		}
+	}
+}
+
+//Begin USceneComponent Interface
+FBoxSphereBounds UCubismVertexAnimationComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	const FBox Box = Animation? Animation->GetBounds() : FBox(ForceInit);
+
+	return FBoxSphereBounds(Box).TransformBy(LocalToWorld);
+}
+//End USceneComponent Interface
+
+//Begin UMeshComponent Interface
+int32 UCubismVertexAnimationComponent::GetNumMaterials() const
+{
+	return MaterialInstances.Num();
+}
+
+UMaterialInterface* UCubismVertexAnimationComponent::GetMaterial(int32 ElementIndex) const
+{
+	return MaterialInstances.IsValidIndex(ElementIndex)? MaterialInstances[ElementIndex] : nullptr;
+}
+
+void UCubismVertexAnimationComponent::GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials) const
+{
+	for (int32 ElementIndex = 0; ElementIndex < GetNumMaterials(); ElementIndex++)
+	{
+		if (UMaterialInterface* Material = GetMaterial(ElementIndex))
+		{
+			OutMaterials.Add(Material);
+		}
+	}
+}
+//End UMeshComponent Interface
+
+// UObject interface
+#if WITH_EDITOR
+void UCubismVertexAnimationComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismVertexAnimationComponent, Animation))
+	{
+		SetAnimation(Animation);
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismVertexAnimationComponent, bRenderMaskedDrawables))
+	{
+		MarkRenderDynamicDataDirty();
+	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(UCubismVertexAnimationComponent, Time))
+	{
+		UpdateOpacities();
+		MarkRenderDynamicDataDirty();
+	}
+}
+#endif
+// End of UObject interface
+
+// UActorComponent interface
+void UCubismVertexAnimationComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// the material instances are transient, so they are recreated whenever the component is registered
+	CreateMaterialInstances();
+}
+
+void UCubismVertexAnimationComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!Animation || Animation->FrameCount == 0)
+	{
+		return;
+	}
+
+	Time += PlayRate * DeltaTime;
+
+	if (bLoop && Animation->Duration > 0.0f)
+	{
+		Time = FMath::Fmod(Time, Animation->Duration);
+
+		if (Time < 0.0f)
+		{
+			Time += Animation->Duration;
+		}
+	}
+	else
+	{
+		Time = FMath::Clamp(Time, 0.0f, Animation->Duration);
+	}
+
+	UpdateOpacities();
+
+	MarkRenderDynamicDataDirty();
+}
+// End of UActorComponent interface
+
+//Begin UPrimitiveComponent Interface
+FPrimitiveSceneProxy* UCubismVertexAnimationComponent::CreateSceneProxy()
+{
+	if (!Animation || Animation->FrameCount == 0)
+	{
+		return nullptr;
+	}
+
+	return new FCubismModelSceneProxy(this);
+}
+//End UPrimitiveComponent Interface
+
+void UCubismVertexAnimationComponent::CreateRenderState_Concurrent(FRegisterComponentContext* Context)
+{
+	Super::CreateRenderState_Concurrent(Context);
+
+	// the new proxy needs the current vertices even if they do not change
+	bTopologyDirty = true;
+
+	SendRenderDynamicData_Concurrent();
+}
+
+void UCubismVertexAnimationComponent::SendRenderDynamicData_Concurrent()
+{
+	Super::SendRenderDynamicData_Concurrent();
+
+	FCubismModelSceneProxy* ModelProxy = static_cast<FCubismModelSceneProxy*>(SceneProxy);
+
+	if (!ModelProxy || Opacities.Num() != Animation->Drawables.Num())
+	{
+		return;
+	}
+
+	int32 FrameIndex;
+	int32 NextFrameIndex;
+	float Alpha;
+	Animation->FindFrames(Time, FrameIndex, NextFrameIndex, Alpha);
+
+	// the render order can not be interpolated, so it is taken from the nearer frame
+	const int32 OrderFrameIndex = Alpha < 0.5f? FrameIndex : NextFrameIndex;
+
+	FCubismModelDynamicMeshData NewDynamicData;
+
+	NewDynamicData.Drawables.Reserve(Animation->Drawables.Num());
+
+	for (int32 DrawableIndex = 0; DrawableIndex < Animation->Drawables.Num(); DrawableIndex++)
+	{
+		const FCubismVertexAnimationDrawable& Drawable = Animation->Drawables[DrawableIndex];
+
+		FCubismDrawableDynamicMeshData& DrawableData = NewDynamicData.Drawables.AddDefaulted_GetRef();
+
+		DrawableData.Index = DrawableIndex;
+		DrawableData.RenderOrder = Animation->GetRenderOrder(OrderFrameIndex, DrawableIndex);
+		DrawableData.bVisible = Opacities[DrawableIndex] > 0.0f && (!Drawable.bMasked || bRenderMaskedDrawables);
+		DrawableData.bTwoSided = Drawable.bTwoSided;
+
+		DrawableData.Color = FLinearColor::White.ToRGBE();
+		DrawableData.Color.A *= Opacities[DrawableIndex];
+
+		// the proxy keeps the buffers of the drawables, so the indices and the UVs are only sent to create them
+		if (bTopologyDirty)
+		{
+			DrawableData.Indices.Reserve(Drawable.VertexIndices.Num());
+			for (const int32 VertexIndex : Drawable.VertexIndices)
+			{
+				DrawableData.Indices.Add(static_cast<uint32>(VertexIndex));
+			}
+
+			DrawableData.UVs = Drawable.VertexUvs;
+		}
+		else if (!DrawableData.bVisible)
+		{
+			continue;
+		}
+
+		DrawableData.Positions.Reserve(Drawable.VertexCount);
+		for (int32 VertexIndex = 0; VertexIndex < Drawable.VertexCount; VertexIndex++)
+		{
+			DrawableData.Positions.Add(FMath::Lerp(
+				Animation->GetVertexPosition(FrameIndex, DrawableIndex, VertexIndex),
+				Animation->GetVertexPosition(NextFrameIndex, DrawableIndex, VertexIndex),
+				Alpha
+			));
+		}
+	}
+
+	bTopologyDirty = false;
+
+	ENQUEUE_RENDER_COMMAND(VertexAnimationUpdateDynamicData)(
+		[ModelProxy, NewDynamicData = MoveTemp(NewDynamicData)](FRHICommandListImmediate& RHICommandList) mutable
+		{
+			ModelProxy->SetDynamicData_RenderThread(RHICommandList, MoveTemp(NewDynamicData));
+		}
+	);
+}
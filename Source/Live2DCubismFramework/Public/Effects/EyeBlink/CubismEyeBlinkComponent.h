@@ -98,8 +98,9 @@ public:
 
 	/**
 	 * The list of IDs of UCubismParameterComponent to which the parameter is applied.
+	 * They are resolved to the parameter indices of the model when the component is set up or they are set.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetIds, Category = "Live2D Cubism")
 	TArray<FString> Ids;
 
 public:
@@ -111,6 +112,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	void Setup(UCubismModelComponent* InModel);
 
+	/**
+	 * @brief The function to set the IDs of the parameters and resolve them to the parameter indices of the model.
+	 * @param InIds The list of the IDs of the parameters.
+	 */
+	UFUNCTION(BlueprintSetter)
+	void SetIds(const TArray<FString>& InIds);
+
 private:
 	/**
 	 * @brief The constructor of the component.
@@ -155,6 +163,8 @@ public:
 	// UActorComponent interface
 	virtual void OnComponentCreated() override;
 
+	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	// End of UActorComponent interface
 };
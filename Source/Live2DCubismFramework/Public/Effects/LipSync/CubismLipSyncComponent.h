@@ -63,8 +63,9 @@ public:
 
 	/**
 	 * The list of the IDs of the UCubismParameterComponent to which the parameter is applied.
+	 * They are resolved to the parameter indices of the model when the component is set up or they are set.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetIds, Category = "Live2D Cubism")
 	TArray<FString> Ids;
 
 	/**
@@ -82,6 +83,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	void Setup(UCubismModelComponent* InModel);
 
+	/**
+	 * @brief The function to set the IDs of the parameters and resolve them to the parameter indices of the model.
+	 * @param InIds The list of the IDs of the parameters.
+	 */
+	UFUNCTION(BlueprintSetter)
+	void SetIds(const TArray<FString>& InIds);
+
 	/**
 	 * @brief The function to get the audio component.
 	 */
@@ -20,4 +20,9 @@ public:
 
 private:
     bool bIsModuleStarted;
+
+	/**
+	 * The handle of the delegate to precache the materials after the engine is initialized.
+	 */
+	FDelegateHandle PostEngineInitHandle;
 };
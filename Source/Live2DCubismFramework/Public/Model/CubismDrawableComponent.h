@@ -14,6 +14,8 @@
 
 class UTexture2D;
 class UTextureRenderTarget2D;
+class UCubismModelMeshComponent;
+struct FCubismDrawableDynamicMeshData;
 
 /**
  * A component to manage a drawable in a Live2D Cubism model.
@@ -38,6 +40,7 @@ public:
 
 	/**
 	 * The order of the drawable for rendering from original model data.
+	 * The value follows the render order of the model updated on every frame.
 	 */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
 	int32 RenderOrder;
@@ -196,7 +199,31 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	int32 GetDrawableMaskCount() const;
 
+	/**
+	 * @brief The function to check whether the drawable contributes to the rendered image.
+	 * @return True if the drawable is visible in the model and its opacity is not zero, false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	bool IsRenderable() const;
+
+	/**
+	 * @brief The function to let the model mesh render the drawable instead of the drawable itself.
+	 * @param InModelMesh The model mesh to render the drawable. If nullptr, the drawable renders itself.
+	 */
+	void SetModelMesh(UCubismModelMeshComponent* InModelMesh);
+
 private:
+	friend class UCubismModelMeshComponent;
+
+	/**
+	 * @brief The function to fill the dynamic mesh data with the current state of the drawable.
+	 * @param OutDynamicData The dynamic mesh data to fill.
+	 * @param bVertexPositions The flag to fill the vertex positions if the drawable is renderable.
+	 * @param bTopology The flag to fill the indices, the UVs and the vertex positions to create the buffers of a new proxy.
+	 */
+	void GetDynamicMeshData(FCubismDrawableDynamicMeshData& OutDynamicData, const bool bVertexPositions, const bool bTopology) const;
+
+
 	/**
 	 * @brief The constructor of the component.
 	 */
@@ -207,6 +234,26 @@ private:
 	 */
 	TObjectPtr<UCubismModelComponent> Model;
 
+	/**
+	 * The model mesh that renders the drawable in place of the drawable itself.
+	 */
+	TObjectPtr<UCubismModelMeshComponent> ModelMesh;
+
+	/**
+	 * The cache of the flag to specify whether the drawable is visible in the model.
+	 */
+	bool bDynamicVisible;
+
+	/**
+	 * The cache of the result of IsRenderable() sent to the rendering thread.
+	 */
+	bool bLastRenderable;
+
+	/**
+	 * The flag to send the indices and the UVs with the next dynamic data, set when the proxy is created.
+	 */
+	bool bTopologyDirty;
+
 	/**
 	 * The flag to indicate whether the rectangle surrounding the vertices that consist of the drawable needs to be updated.
 	 */
@@ -250,6 +297,7 @@ private:
 public:
 	//Begin USceneComponent Interface
 	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	virtual void OnVisibilityChanged() override;
 	//End USceneComponent Interface
 
 private:
@@ -273,7 +321,11 @@ private:
 
 	//Begin UPrimitiveComponent Interface
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+	virtual void CollectPSOPrecacheData(const FPSOPrecacheParams& BasePrecachePSOParams, FMaterialInterfacePSOPrecacheParamsList& OutParams) override;
+#endif
 	//End UPrimitiveComponent Interface
 
+	virtual void CreateRenderState_Concurrent(FRegisterComponentContext* Context) override;
 	virtual void SendRenderDynamicData_Concurrent() override;
 };
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Live2DCubismCore.h"
+#include "Rendering/CubismMaterialPermutation.h"
 
 #include "CubismMoc3.generated.h"
 
@@ -105,6 +106,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	int32 GetSizeOfModel() const;
 
+	/**
+	 * @brief The function to get the materials that the drawables of the moc need.
+	 * @return The list of the material permutations with the number of drawables using each of them.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	TArray<FCubismMaterialPermutation> GetMaterialPermutations() const;
+
+	/**
+	 * @brief The function to log the materials that the drawables of the moc need as a report.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	void LogMaterialPermutations() const;
+
 private:
 	friend class UCubismMoc3Factory;
 
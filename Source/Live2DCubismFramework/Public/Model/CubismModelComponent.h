@@ -110,6 +110,18 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Live2D Cubism")
 	TObjectPtr<UCubismPoseComponent> Pose;
 
+	/**
+	 * The indices of the parameters of the eye blink effect.
+	 * They are resolved from the IDs of the eye blink component and scaled by the `EyeBlink` curves of the motions.
+	 */
+	TArray<int32> EyeBlinkParameterIndices;
+
+	/**
+	 * The indices of the parameters of the lip sync effect.
+	 * They are resolved from the IDs of the lip sync component and offset by the `LipSync` curves of the motions.
+	 */
+	TArray<int32> LipSyncParameterIndices;
+
 	/**
 	 * The list of textures that the model uses.
 	 */
@@ -154,6 +166,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	void Setup();
 
+	/**
+	 * @brief The function to write the staged parameter values to the model and update the drawables.
+	 * @note This function is called on every tick. Call it directly only to sample the drawables outside of the tick.
+	 */
+	void UpdateModel();
+
 	////
 
 	/**
@@ -259,6 +277,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	UCubismParameterComponent* GetParameter(const FString ParameterId);
 
+	/**
+	 * @brief The function to get the indices of the parameters with the specified IDs.
+	 * If a parameter is not in the original model, the function registers the parameter.
+	 * @param ParameterIds The IDs of the parameters.
+	 * @param OutParameterIndices The indices of the parameters. The empty IDs are skipped.
+	 */
+	void GetParameterIndices(const TArray<FString>& ParameterIds, TArray<int32>& OutParameterIndices);
+
 	////
 
 	/**
@@ -315,6 +341,7 @@ private:
 // The interface for drawable components.
 private:
 	friend class UCubismDrawableComponent;
+	friend class UCubismVertexAnimationBaker;
 
 	/**
 	 * @brief The function to get the blend mode of the drawable at the specified index.
@@ -533,9 +560,16 @@ private:
 	 * @brief The function to set the value of the parameter at the specified index.
 	 * @param ParameterIndex The index of the parameter.
 	 * @param Value The value to set.
+	 * @note The value is staged and written to the model, clamped, when the model is updated.
 	 */
 	void SetParameterValue(const int32 ParameterIndex, const float Value);
 
+	/**
+	 * @brief The function to write the staged values of the parameters to the model.
+	 * @note This function should be called right before the model is updated.
+	 */
+	void CommitParameterValues();
+
 	/**
 	 * @brief The function to get the number of keys of the parameter at the specified index.
 	 * @param ParameterIndex The index of the parameter.
@@ -574,6 +608,17 @@ private:
 	UPROPERTY()
 	TMap<int32, float> NonNativeParameterValues;
 
+	/**
+	 * The values of the parameters blended in the current frame and not written to the model yet, in the order of the parameters.
+	 * The components update the parameters in the order of their ticks, and all of them tick before the model.
+	 */
+	TArray<float> StagedParameterValues;
+
+	/**
+	 * The flags of the parameters that have staged values.
+	 */
+	TBitArray<> StagedParameterFlags;
+
 // The interface for part components.
 private:
 	friend class UCubismPartComponent;
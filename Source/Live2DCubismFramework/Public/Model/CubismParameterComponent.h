@@ -82,6 +82,7 @@ public:
 	 * @brief The function to set the value of the parameter.
 	 * @param TargetValue The value to set.
 	 * @param Weight The [0,1] weight to specify interpolation between the current value and `TargetValue`.
+	 * @note The value is blended into the values staged in the model in the current frame, and clamped once when the model is updated.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	void SetParameterValue(float TargetValue, const float Weight = 1.0f);
@@ -113,6 +114,12 @@ private:
 	 */
 	TObjectPtr<UCubismModelComponent> Model;
 
+	/**
+	 * @brief The function to stage the blended value of the parameter in the model.
+	 * @param CurrentValue The blended value, which may be out of the range of the parameter.
+	 */
+	void StageParameterValue(const float CurrentValue);
+
 public:
 	// UObject interface
 	virtual void PostLoad() override;
@@ -8,8 +8,9 @@
 
 #pragma once
 
-#include "Motion/CubismMotion3Json.h"
-#include "Engine/CurveTable.h"
+#include "Motion/CubismMotionData.h"
+
+class UCubismModelComponent;
 
 /**
  * An enumeration of the states of the motion.
@@ -35,6 +36,14 @@ public:
 	 */
 	FCubismMotion(const UCubismMotion3Json* Json, const float InOffsetTime);
 
+	/**
+	 * The function to reset the motion to play a json asset from the start.
+	 * @param Json The json asset that contains the motion information.
+	 * @param InOffsetTime The delay time from the start of the motion to the start of the fade-in.
+	 * @note The arrays keep their allocations, so that a finished motion can be reused without allocation.
+	 */
+	void Reset(const UCubismMotion3Json* Json, const float InOffsetTime);
+
 	/**
 	 * The duration of the motion. (seconds)
 	 */
@@ -61,19 +70,35 @@ public:
 	float FadeOutTime;
 
 	/**
-	 * The curves of the motion.
+	 * The curves and events of the motion shared with the other motions playing the same json asset.
 	 */
-	TArray<FCubismMotionCurve> Curves;
+	TSharedPtr<const FCubismMotionData> Data;
 
 	/**
-	 * The curve table that contains the curves.
+	 * The indices of the parameters that the curves are applied to, in the order of the curves.
+	 * The index is INDEX_NONE for the curves that do not target a parameter.
 	 */
-	TObjectPtr<UCurveTable> CurveTable;
+	TArray<int32> ParameterIndices;
 
 	/**
-	 * The events of the motion.
+	 * The index of the segment evaluated last for each curve, to continue the search of the segment from it.
 	 */
-	TArray<FCubismMotionEvent> Events;
+	TArray<int32> SegmentCursors;
+
+	/**
+	 * The values of the curves evaluated last, in the order of the curves.
+	 */
+	TArray<float> CurveValues;
+
+	/**
+	 * The time in the motion up to which the events have been dispatched. (seconds)
+	 */
+	float LastEventTime;
+
+	/**
+	 * The index of the first event not dispatched yet in the current loop.
+	 */
+	int32 EventCursor;
 
 	/**
 	 * The start time of the motion. (seconds)
@@ -91,6 +116,13 @@ public:
 	float EndTime;
 
 public:
+	/**
+	 * The function to resolve the parameters that the curves are applied to.
+	 * @param Model The model to apply the motion to.
+	 * @note The parameters not found in the model are added to it as non-native parameters.
+	 */
+	void Bind(UCubismModelComponent* Model);
+
 	/**
 	 * The function to initialize the state of the motion.
 	 * @param Time The current time.
@@ -188,9 +220,9 @@ private:
 		return 0.5f - 0.5f * FMath::Cos(PI * Value);
 	}
 
-	float GetValue(const FString Id, const float Time) const
+	void EvaluateCurves(const float Time)
 	{
-		return CurveTable->FindRichCurve(*Id, Id)->Eval(Time, 0.0f);
+		Data->EvaluateAll(Time, SegmentCursors, CurveValues);
 	}
 
 	float Weight;
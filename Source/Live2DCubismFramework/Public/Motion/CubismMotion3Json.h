@@ -8,8 +8,13 @@
 
 #pragma once
 
+#include "Serialization/BulkData.h"
+
 #include "CubismMotion3Json.generated.h"
 
+class FCubismMotionData;
+struct FCubismMotionSegmentData;
+
 /**
  * An enumeration to specify the target of motion.
  */
@@ -22,6 +27,30 @@ enum class ECubismMotionCurveTarget : uint8
 	PartOpacity,
 };
 
+/**
+ * An enumeration of the effects of the curves targeting the model.
+ */
+UENUM(BlueprintType)
+enum class ECubismMotionModelCurve : uint8
+{
+	None,
+	Opacity,
+	EyeBlink,
+	LipSync,
+};
+
+/**
+ * An enumeration of the types of the segments in a curve.
+ */
+UENUM(BlueprintType)
+enum class ECubismMotionSegmentType : uint8
+{
+	Linear = 0,
+	Bezier = 1,
+	Stepped = 2,
+	InverseStepped = 3,
+};
+
 /**
  * A structure corresponding to an array element of the `Curves` field in a motion object.
  */
@@ -42,6 +71,12 @@ struct LIVE2DCUBISMFRAMEWORK_API FCubismMotionCurve
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Curve")
 	ECubismMotionCurveTarget Target;
 
+	/**
+	 * The effect of the curve, classified from the `Id` field if the curve targets the model.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Curve")
+	ECubismMotionModelCurve ModelCurve = ECubismMotionModelCurve::None;
+
 	/**
 	 * The property corresponding to the `FadeInTime` field in a curve object.
 	 */
@@ -53,6 +88,26 @@ struct LIVE2DCUBISMFRAMEWORK_API FCubismMotionCurve
 	 */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Curve")
 	float FadeOutTime = -1.0f;
+
+	/**
+	 * The index of the first segment of the curve in the segments of the motion.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Curve")
+	int32 BaseSegmentIndex = 0;
+
+	/**
+	 * The number of the segments of the curve.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Curve")
+	int32 SegmentCount = 0;
+
+	/**
+	 * @brief The function to classify the ID of a curve targeting the model.
+	 * @param Id The ID of the curve.
+	 * @return The effect of the curve, or None if the ID is unknown.
+	 * @note `PartOpacity` is regarded as the opacity of the model, as the motions made for the older versions use it.
+	 */
+	static ECubismMotionModelCurve ClassifyModelCurve(const FString& Id);
 };
 
 /**
@@ -76,6 +131,85 @@ struct LIVE2DCUBISMFRAMEWORK_API FCubismMotionEvent
 	FString Value;
 };
 
+/**
+ * A structure to specify how the curves of a motion are compressed in cooked packages.
+ */
+USTRUCT(BlueprintType)
+struct LIVE2DCUBISMFRAMEWORK_API FCubismMotionCompressionSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * The flag to specify whether to compress the curves in cooked packages.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Compression")
+	bool bEnabled = false;
+
+	/**
+	 * The flag to specify whether to quantize the times of the points to 1/16 of a frame at the frame rate of the motion.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Compression", meta = (EditCondition = "bEnabled"))
+	bool bQuantizeTimes = true;
+
+	/**
+	 * The flag to specify whether to quantize the values of the points to 16 bits in the range of each curve.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Compression", meta = (EditCondition = "bEnabled"))
+	bool bQuantizeValues = true;
+
+	/**
+	 * The maximum difference of the values allowed when removing the points between the linear segments.
+	 * If zero, no points are removed.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Compression", meta = (EditCondition = "bEnabled", ClampMin = "0.0"))
+	float LinearTolerance = 0.001f;
+};
+
+/**
+ * A structure to report the result of the compression of the curves of a motion.
+ */
+USTRUCT(BlueprintType)
+struct LIVE2DCUBISMFRAMEWORK_API FCubismMotionCompressionStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * The byte size of the segments and the points before the compression.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	int32 UncompressedSize = 0;
+
+	/**
+	 * The byte size of the segments and the points after the compression.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	int32 CompressedSize = 0;
+
+	/**
+	 * The number of the points removed between the linear segments.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	int32 RemovedPointCount = 0;
+
+	/**
+	 * The maximum difference of the values of the curves from the uncompressed ones.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	float MaxError = 0.0f;
+
+	/**
+	 * The average difference of the values of the curves from the uncompressed ones.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	float AverageError = 0.0f;
+
+	/**
+	 * The ID of the curve with the maximum difference.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	FString MaxErrorCurveId;
+};
+
 /**
  * A class to hold the motion data read from motion3.json file.
  */
@@ -115,6 +249,13 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Motion Data")
 	float FadeOutTime;
 
+	/**
+	 * The property corresponding to the `AreBeziersRestricted` field in a `Meta` field.
+	 * If true, the control points of the Bezier segments do not exceed the end points in time.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Motion Data")
+	bool bAreBeziersRestricted = false;
+
 	/**
 	 * The property corresponding to the `Curves` field in a motion object.
 	 */
@@ -133,6 +274,89 @@ public:
 	 */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Motion Data")
 	TArray<FCubismMotionEvent> Events;
+
+	/**
+	 * The types of the segments of all curves, as written in the `Segments` fields.
+	 * In cooked packages, the segments and the points are stored in the bulk data instead, and loaded on the first play of the motion.
+	 */
+	UPROPERTY()
+	TArray<ECubismMotionSegmentType> SegmentTypes;
+
+	/**
+	 * The index of the first point of each segment in the points of the motion.
+	 */
+	UPROPERTY()
+	TArray<int32> SegmentBasePointIndices;
+
+	/**
+	 * The times of the points of all segments. (seconds)
+	 */
+	UPROPERTY()
+	TArray<float> PointTimes;
+
+	/**
+	 * The values of the points of all segments.
+	 */
+	UPROPERTY()
+	TArray<float> PointValues;
+
+	/**
+	 * The settings to compress the curves in cooked packages.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Compression")
+	FCubismMotionCompressionSettings CompressionSettings;
+
+	/**
+	 * The result of the compression with the current settings.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	FCubismMotionCompressionStats CompressionStats;
+
+	/**
+	 * The flag to specify whether the motion is played from the frames sampled at its Fps instead of evaluating the curves.
+	 * The frames are sampled once and shared by all motions playing this asset, which suits the idle motions looping on many models.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pose Cache")
+	bool bUsePoseCache = false;
+
+public:
+	/**
+	 * @brief The function to get the curves of the motion prepared for the evaluation.
+	 * @return The motion data shared by all motions playing this asset.
+	 * @note The motion data is built on the first call if it has not been built on load.
+	 */
+	TSharedPtr<const FCubismMotionData> GetMotionData() const;
+
+private:
+	/**
+	 * The motion data built from the properties of the asset.
+	 */
+	mutable TSharedPtr<const FCubismMotionData> MotionData;
+
+	/**
+	 * The segments and the points packed in cooked packages.
+	 */
+	mutable FByteBulkData SegmentBulkData;
+
+	friend class FCubismMotionData;
+
+	/**
+	 * @brief The function to load the segments and the points packed in cooked packages.
+	 * @param OutSegmentData The segments and the points, decompressed if they are compressed.
+	 * @return True if the packed segments are loaded, false if there are none.
+	 * @note The memory of the bulk data is released after loading.
+	 */
+	bool LoadSegmentBulkData(FCubismMotionSegmentData& OutSegmentData) const;
+
+public:
+	// UObject interface
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
+
+#if WITH_EDITORONLY_DATA
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	// End of UObject interface
 };
 
 /**
@@ -16,6 +16,8 @@ class UCubismModelComponent;
 class FCubismMotion;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FCubismMotionPlaybackFinishedHandler);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCubismMotionEventHandler, FName, Value);
+DECLARE_MULTICAST_DELEGATE_OneParam(FCubismMotionEventNativeHandler, FName);
 
 /**
  * An enumeration of the priority of the motion.
@@ -29,6 +31,108 @@ enum class ECubismMotionPriority : uint8
 	Force,
 };
 
+/**
+ * A structure to hold a named group of the motions, corresponding to a motion group in a model3.json.
+ */
+USTRUCT(BlueprintType)
+struct LIVE2DCUBISMFRAMEWORK_API FCubismMotionGroup
+{
+	GENERATED_BODY()
+
+	/**
+	 * The name of the group.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	FName Name;
+
+	/**
+	 * The indices of the json assets of the motions in the group.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	TArray<int32> Indices;
+
+	/**
+	 * The position in the indices of the motion to play next in sequence.
+	 */
+	int32 NextPosition = 0;
+};
+
+/**
+ * An enumeration of the way the motions of a layer are blended with the motions below the layer.
+ */
+UENUM()
+enum class ECubismMotionLayerBlendMode : uint8
+{
+	Override,
+	Additive,
+};
+
+/**
+ * A structure to hold a layer of the motions played over the base motions.
+ */
+USTRUCT(BlueprintType)
+struct LIVE2DCUBISMFRAMEWORK_API FCubismMotionLayer
+{
+	GENERATED_BODY()
+
+	/**
+	 * The way the motions of the layer are blended.
+	 * Override interpolates towards the values of the motions, Additive adds the differences of the values of the motions from the default values of the parameters.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	ECubismMotionLayerBlendMode BlendMode = ECubismMotionLayerBlendMode::Override;
+
+	/**
+	 * The weight of the layer.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism", meta = (ClampMin = "0.0", ClampMax = "1.0", SliderMin = "0.0", SliderMax = "1.0"))
+	float Weight = 1.0f;
+
+	/**
+	 * The IDs of the parameters the layer applies to.
+	 * If empty, the layer applies to all parameters.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	TArray<FString> ParameterIds;
+
+	/**
+	 * The queue of the motions to play in the layer.
+	 */
+	TArray<TSharedPtr<FCubismMotion>> MotionQueue;
+
+	/**
+	 * The flags of the parameters the layer applies to, in the order of the parameters of the model.
+	 * It is rebuilt from the IDs when the number of the parameters changes or a motion is played in the layer.
+	 */
+	TBitArray<> ParameterMask;
+};
+
+/**
+ * A structure to hold a value of a curve to blend into a parameter.
+ */
+struct FCubismMotionBlend
+{
+	/**
+	 * The index of the parameter.
+	 */
+	int32 ParameterIndex;
+
+	/**
+	 * The value of the curve.
+	 */
+	float Value;
+
+	/**
+	 * The weight to interpolate the parameter towards the value with.
+	 */
+	float Weight;
+
+	/**
+	 * The flag to specify whether the value replaces the parameter instead of being interpolated.
+	 */
+	bool bOverride;
+};
+
 /**
  * A component to apply the motion to the specified parameters of the Cubism model.
  */
@@ -50,12 +154,25 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
 	TArray<TObjectPtr<UCubismMotion3Json>> Jsons;
 
+	/**
+	 * The named groups of the json assets.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	TArray<FCubismMotionGroup> Groups;
+
 	/**
 	 * The playback speed of the motion.
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism", meta = (ClampMin = "0.0", SliderMin = "0.0", SliderMax = "10.0"))
 	float Speed = 1.0f;
 
+	/**
+	 * The time step to advance the motions by. (seconds)
+	 * If zero, the motions are advanced by the time elapsed in each tick. Otherwise, they are advanced by whole steps and the rest of the time is carried over to the next tick.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism", meta = (ClampMin = "0.0", SliderMin = "0.0", SliderMax = "0.1"))
+	float FixedTimeStep = 0.0f;
+
 	/**
 	 * The current priority of the motion.
 	 * If no motion is playing, the priority is None.
@@ -76,6 +193,23 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Live2D Cubism")
 	FCubismMotionPlaybackFinishedHandler OnMotionPlaybackFinished;
 
+	/**
+	 * The delegate to be called when the playing motion reaches an event.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Live2D Cubism")
+	FCubismMotionEventHandler OnMotionEvent;
+
+	/**
+	 * The delegate for native code to be called when the playing motion reaches an event.
+	 */
+	FCubismMotionEventNativeHandler OnMotionEventNative;
+
+	/**
+	 * The layers of the motions played over the base motions, in the order of blending.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	TArray<FCubismMotionLayer> Layers;
+
 public:
 	/**
 	 * @brief The function to set up the component.
@@ -109,13 +243,78 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	void PlayMotion(const int32 InIndex, const float OffsetTime=0.0f, const ECubismMotionPriority Priority=ECubismMotionPriority::Normal);
 
+	/**
+	 * @brief The function to move the playing motions to a time.
+	 * @param MotionTime The time in the motions to move to. (seconds)
+	 * @note The motions of the layers are also moved. The events between the current and the new time are not notified.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	void SeekMotions(const float MotionTime);
+
+	/**
+	 * @brief The function to find a group of the motions.
+	 * @param GroupName The name of the group.
+	 * @return The index of the group, or INDEX_NONE if not found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	int32 FindGroup(const FName GroupName) const;
+
+	/**
+	 * @brief The function to play a motion chosen at random from a group.
+	 * @param GroupName The name of the group.
+	 * @param OffsetTime The delay time from the start of the motion to the start of the fade-in.
+	 * @param Priority The priority of the motion.
+	 * @return The index of the json asset played, or INDEX_NONE if no motion is played.
+	 * @note The motion is not played unless the priority is Force or higher than the current and the reserved priorities.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	int32 PlayRandomInGroup(const FName GroupName, const float OffsetTime=0.0f, const ECubismMotionPriority Priority=ECubismMotionPriority::Normal);
+
+	/**
+	 * @brief The function to play the motions of a group in sequence.
+	 * @param GroupName The name of the group.
+	 * @param OffsetTime The delay time from the start of the motion to the start of the fade-in.
+	 * @param Priority The priority of the motion.
+	 * @return The index of the json asset played, or INDEX_NONE if no motion is played.
+	 * @note The motion is not played unless the priority is Force or higher than the current and the reserved priorities.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	int32 PlayNextInGroup(const FName GroupName, const float OffsetTime=0.0f, const ECubismMotionPriority Priority=ECubismMotionPriority::Normal);
+
 	/**
 	 * @brief The function to stop the motion.
 	 * @param bForce True if the motion is forced to stop, false otherwise.
+	 * @note The motions of the layers are also stopped.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	void StopAllMotions(const bool bForce = false);
 
+	/**
+	 * @brief The function to check if the all motions of a layer are finished.
+	 * @param LayerIndex The index of the layer.
+	 * @return True if the all motions of the layer are finished, false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	bool IsLayerFinished(const int32 LayerIndex) const;
+
+	/**
+	 * @brief The function to play the motion in a layer.
+	 * @param LayerIndex The index of the layer.
+	 * @param InIndex The index of the json asset that contains the motion information.
+	 * @param OffsetTime The delay time from the start of the motion to the start of the fade-in.
+	 * @note The motions playing in the layer fade out, while the base motions and the other layers are not affected.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	void PlayMotionInLayer(const int32 LayerIndex, const int32 InIndex, const float OffsetTime=0.0f);
+
+	/**
+	 * @brief The function to stop the motions of a layer.
+	 * @param LayerIndex The index of the layer.
+	 * @param bForce True if the motions are forced to stop, false otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	void StopAllMotionsInLayer(const int32 LayerIndex, const bool bForce = false);
+
 private:
 	/**
 	 * @brief The constructor of the component.
@@ -132,16 +331,122 @@ private:
 	 */
 	float Time;
 
+	/**
+	 * The time elapsed but not advanced yet, if the fixed time step is used.
+	 */
+	float TimeAccumulator;
+
+	/**
+	 * @brief The function to move a motion to a time.
+	 * @param CubismMotion The motion to move.
+	 * @param MotionTime The time in the motion to move to. (seconds)
+	 */
+	void SeekMotion(FCubismMotion& CubismMotion, const float MotionTime);
+
 	/**
 	 * The queue of the motion to play.
 	 */
 	TArray<TSharedPtr<FCubismMotion>> MotionQueue;
 
+	/**
+	 * The motions finished or stopped, kept to be reused by the motions played next.
+	 */
+	TArray<TSharedPtr<FCubismMotion>> MotionPool;
+
+	/**
+	 * @brief The function to play a motion of a group with the priority check.
+	 * @param GroupIndex The index of the group.
+	 * @param Position The position of the motion in the group.
+	 * @param OffsetTime The delay time from the start of the motion to the start of the fade-in.
+	 * @param Priority The priority of the motion.
+	 * @return The index of the json asset played, or INDEX_NONE if no motion is played.
+	 */
+	int32 PlayInGroup(const int32 GroupIndex, const int32 Position, const float OffsetTime, const ECubismMotionPriority Priority);
+
+	/**
+	 * @brief The function to get a motion to play from the pool, or create one if the pool is empty.
+	 * @param Json The json asset that contains the motion information.
+	 * @param OffsetTime The delay time from the start of the motion to the start of the fade-in.
+	 * @return The motion reset to play the json asset, and bound to the model.
+	 */
+	TSharedPtr<FCubismMotion> AcquireMotion(const UCubismMotion3Json* Json, const float OffsetTime);
+
+	/**
+	 * @brief The function to return the motions of a queue to the pool.
+	 * @param Queue The queue of the motions. It is emptied.
+	 */
+	void ReleaseMotions(TArray<TSharedPtr<FCubismMotion>>& Queue);
+
+	/**
+	 * The values of the parameters blended in the current tick, in the order of the parameters of the model.
+	 */
+	TArray<float> ParameterValues;
+
+	/**
+	 * The flags of the parameters written by the motions in the current tick.
+	 */
+	TBitArray<> BlendedParameters;
+
+	/**
+	 * The values of the parameters blended by the layer being evaluated.
+	 */
+	TArray<float> LayerParameterValues;
+
+	/**
+	 * The flags of the parameters written by the layer being evaluated.
+	 */
+	TBitArray<> LayerBlendedParameters;
+
+	/**
+	 * The values of the curves of the motions in a queue, compiled in the order of the motions and blended per parameter at once.
+	 */
+	TArray<FCubismMotionBlend> BlendList;
+
+	/**
+	 * The values of the events reached in the current tick, in the order they are reached.
+	 * They are broadcast after all motions are updated, so that the handlers can play other motions.
+	 */
+	TArray<FName> FiredEvents;
+
+	/**
+	 * @brief The function to collect the events of a motion reached since the last update.
+	 * @param CubismMotion The motion to collect the events of.
+	 * @param MotionTime The current time in the motion. (seconds)
+	 * @note If the time is before the last one, the motion is regarded as looped and the events until the end of the last loop are collected first.
+	 */
+	void CollectEvents(FCubismMotion& CubismMotion, const float MotionTime);
+
+	/**
+	 * @brief The function to rebuild the parameter mask of a layer from its parameter IDs.
+	 * @param Layer The layer to rebuild.
+	 */
+	void UpdateLayerMask(FCubismMotionLayer& Layer) const;
+
+	/**
+	 * @brief The function to update the motions of a queue.
+	 * @param Queue The queue of the motions to update. The finished motions are removed.
+	 * @param ModelWeight The weight to apply the model curves with. If zero, the model curves are ignored.
+	 * @param Values The values of the parameters to blend the motions into.
+	 * @param BlendedFlags The flags of the parameters written by the motions.
+	 */
+	void UpdateMotionQueue(TArray<TSharedPtr<FCubismMotion>>& Queue, const float ModelWeight, TArray<float>& Values, TBitArray<>& BlendedFlags);
+
 	/**
 	 * @brief The function to update the motion.
 	 * @param Motion The motion to update.
+	 * @param ModelWeight The weight to apply the model curves with. If zero, the model curves are ignored.
+	 * @note The values of the parameter curves are added to the blend list instead of being blended.
+	 * The `EyeBlink` and `LipSync` model curves scale and offset the parameters of the effects of the model, as the Cubism SDK for Native does.
+	 */
+	void UpdateMotion(float UserTimeSeconds, float FadeWeight, const TSharedPtr<FCubismMotion>& CubismMotion, const float ModelWeight);
+
+	/**
+	 * @brief The function to blend the blend list into the parameters and empty it.
+	 * @param Values The values of the parameters to blend the list into.
+	 * @param BlendedFlags The flags of the parameters written by the list.
+	 * @note Each parameter is read and written once, folding its values in the order of the motions, so the result is the same as blending the motions one by one.
 	 */
-	void UpdateMotion(float UserTimeSeconds, float FadeWeight, const TSharedPtr<FCubismMotion>& CubismMotion);
+	void ApplyBlendList(TArray<float>& Values, TBitArray<>& BlendedFlags);
 
 public:
 	// UObject interface
@@ -0,0 +1,251 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Motion/CubismMotion3Json.h"
+#include "Engine/CurveTable.h"
+
+/**
+ * A structure to hold the segments and the points of all curves of a motion.
+ */
+struct FCubismMotionSegmentData
+{
+	/**
+	 * The index of the first segment of each curve.
+	 * If empty, the indices of the curves are used.
+	 */
+	TArray<int32> CurveBaseSegmentIndices;
+
+	/**
+	 * The number of the segments of each curve.
+	 * If empty, the numbers of the curves are used.
+	 */
+	TArray<int32> CurveSegmentCounts;
+
+	/**
+	 * The types of the segments.
+	 */
+	TArray<ECubismMotionSegmentType> SegmentTypes;
+
+	/**
+	 * The index of the first point of each segment.
+	 */
+	TArray<int32> SegmentBasePointIndices;
+
+	/**
+	 * The times of the points. (seconds)
+	 */
+	TArray<float> PointTimes;
+
+	/**
+	 * The values of the points.
+	 */
+	TArray<float> PointValues;
+};
+
+/**
+ * A class to hold the curves of a motion in a form ready to be evaluated.
+ * The data is built once per json asset and shared by all motions playing it, so it must not be modified after construction.
+ */
+class LIVE2DCUBISMFRAMEWORK_API FCubismMotionData
+{
+public:
+	/**
+	 * The constructor.
+	 * @param Json The json asset that contains the motion information.
+	 */
+	FCubismMotionData(const UCubismMotion3Json* Json);
+
+	/**
+	 * The constructor.
+	 * @param Json The json asset that contains the motion information.
+	 * @param SegmentData The segments of the curves to use instead of those of the json asset.
+	 */
+	FCubismMotionData(const UCubismMotion3Json* Json, FCubismMotionSegmentData&& SegmentData);
+
+	/**
+	 * @brief The function to evaluate a curve.
+	 * @param CurveIndex The index of the curve.
+	 * @param Time The time in the motion. (seconds)
+	 * @return The value of the curve at the time.
+	 */
+	float Evaluate(const int32 CurveIndex, const float Time) const;
+
+	/**
+	 * @brief The function to evaluate a curve starting the search of the segment from the cached one.
+	 * @param CurveIndex The index of the curve.
+	 * @param Time The time in the motion. (seconds)
+	 * @param Cursor The index of the segment found in the last evaluation of the curve, or INDEX_NONE. It is updated to the segment found.
+	 * @return The value of the curve at the time.
+	 * @note The search restarts from the first segment of the curve if the time is before the cached segment, and falls back to the binary search if the time is far after it.
+	 */
+	float Evaluate(const int32 CurveIndex, const float Time, int32& Cursor) const;
+
+	/**
+	 * @brief The function to evaluate all curves at once.
+	 * @param Time The time in the motion. (seconds)
+	 * @param Cursors The index of the segment found in the last evaluation of each curve. They are updated to the segments found.
+	 * @param OutValues The values of the curves at the time, in the order of the curves.
+	 * @note The linear and restricted Bezier segments of several curves are evaluated together with vector instructions.
+	 * If the pose cache is built, the values are interpolated between the cached frames instead, and the cursors are not used.
+	 */
+	void EvaluateAll(const float Time, TArray<int32>& Cursors, TArray<float>& OutValues) const;
+
+	/**
+	 * The curves of the motion.
+	 */
+	TArray<FCubismMotionCurve> Curves;
+
+	/**
+	 * The flag to specify whether the curves are evaluated from the segments of the motion3.json.
+	 * If false, the curves are evaluated from the curve table, as the assets imported by the older versions have no segments.
+	 */
+	bool bUseSegments;
+
+	/**
+	 * The flag to specify whether the control points of the Bezier segments do not exceed the end points in time.
+	 */
+	bool bAreBeziersRestricted;
+
+	/**
+	 * The types of the segments of all curves.
+	 */
+	TArray<ECubismMotionSegmentType> SegmentTypes;
+
+	/**
+	 * The index of the first point of each segment.
+	 */
+	TArray<int32> SegmentBasePointIndices;
+
+	/**
+	 * The times of the points of all segments. (seconds)
+	 */
+	TArray<float> PointTimes;
+
+	/**
+	 * The values of the points of all segments.
+	 */
+	TArray<float> PointValues;
+
+	/**
+	 * The number of the frames in the pose cache.
+	 * If zero, the pose cache is not used.
+	 */
+	int32 PoseCacheFrameCount;
+
+	/**
+	 * The time between the frames in the pose cache. (seconds)
+	 */
+	float PoseCacheFrameTime;
+
+	/**
+	 * The values of all curves at the frames in the pose cache, frame by frame in the order of the curves.
+	 */
+	TArray<float> PoseCacheValues;
+
+	/**
+	 * The curves in the curve table, in the order of the curves.
+	 * Only used if the curves are not evaluated from the segments.
+	 * The curves not found in the curve table are excluded from the indices below.
+	 */
+	TArray<const FRichCurve*> RichCurves;
+
+	/**
+	 * The indices of the curves targeting the model.
+	 */
+	TArray<int32> ModelCurveIndices;
+
+	/**
+	 * The indices of the curves targeting the parameters.
+	 */
+	TArray<int32> ParameterCurveIndices;
+
+	/**
+	 * The indices of the curves targeting the opacities of the parts.
+	 */
+	TArray<int32> PartOpacityCurveIndices;
+
+	/**
+	 * The curve table that contains the curves.
+	 */
+	TObjectPtr<UCurveTable> CurveTable;
+
+	/**
+	 * The times of the events of the motion, sorted in ascending order. (seconds)
+	 */
+	TArray<float> EventTimes;
+
+	/**
+	 * The values of the events of the motion, in the order of the times.
+	 */
+	TArray<FName> EventValues;
+
+private:
+	/**
+	 * The number of the segments searched linearly from the cached segment before the binary search.
+	 */
+	static constexpr int32 LinearSearchCount = 4;
+
+	/**
+	 * @brief The function to get the segments of the curves of a json asset.
+	 * @param Json The json asset that contains the motion information.
+	 * @return The segments packed in the cooked package if any, otherwise the segments of the json asset.
+	 */
+	static FCubismMotionSegmentData LoadSegmentData(const UCubismMotion3Json* Json);
+
+	/**
+	 * @brief The function to find the segment of a curve containing a time.
+	 * @param CurveIndex The index of the curve.
+	 * @param Time The time in the motion. (seconds)
+	 * @param Cursor The index of the segment found in the last evaluation of the curve, or INDEX_NONE. It is updated to the segment found.
+	 * @return True if a segment is found, false if the time is past the last point of the curve.
+	 */
+	bool FindSegment(const int32 CurveIndex, const float Time, int32& Cursor) const;
+
+	/**
+	 * @brief The function to get the time at which a segment ends.
+	 * @param SegmentIndex The index of the segment.
+	 * @return The time of the last point of the segment, which is the first point of the next segment. (seconds)
+	 */
+	float GetSegmentEndTime(const int32 SegmentIndex) const
+	{
+		return PointTimes[GetSegmentEndPointIndex(SegmentIndex)];
+	}
+
+	/**
+	 * @brief The function to get the last point of a segment.
+	 * @param SegmentIndex The index of the segment.
+	 * @return The index of the last point of the segment.
+	 */
+	int32 GetSegmentEndPointIndex(const int32 SegmentIndex) const
+	{
+		return SegmentBasePointIndices[SegmentIndex] + (SegmentTypes[SegmentIndex] == ECubismMotionSegmentType::Bezier? 3 : 1);
+	}
+
+	/**
+	 * @brief The function to evaluate a segment.
+	 * @param SegmentIndex The index of the segment.
+	 * @param Time The time in the motion. (seconds)
+	 * @return The value of the segment at the time.
+	 */
+	float EvaluateSegment(const int32 SegmentIndex, const float Time) const;
+
+	/**
+	 * @brief The function to sample all curves into the pose cache.
+	 * @param Duration The duration of the motion. (seconds)
+	 * @param Fps The frame rate to sample the curves at.
+	 */
+	void BuildPoseCache(const float Duration, const float Fps);
+
+	/**
+	 * @brief The function to check whether the segments of the curves are consistent with the points.
+	 * @return True if all curves can be evaluated from the segments, false otherwise.
+	 */
+	bool ValidateSegments() const;
+};
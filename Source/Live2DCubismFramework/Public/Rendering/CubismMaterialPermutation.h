@@ -0,0 +1,95 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Model/CubismModelComponent.h"
+
+#include "CubismMaterialPermutation.generated.h"
+
+class UMaterialInterface;
+
+/**
+ * A structure to describe the material used to render a drawable.
+ */
+USTRUCT(BlueprintType)
+struct LIVE2DCUBISMFRAMEWORK_API FCubismMaterialPermutation
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * The blend mode of the drawables.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	ECubismDrawableBlendMode BlendMode = ECubismDrawableBlendMode::Normal;
+
+	/**
+	 * The flag to specify whether the drawables are masked.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	bool bMasked = false;
+
+	/**
+	 * The flag to specify whether the masks of the drawables are inverted.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	bool bInvertedMask = false;
+
+	/**
+	 * The number of drawables using the material.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	int32 NumDrawables = 0;
+
+	/**
+	 * @brief The function to get the name of the material asset.
+	 * @return The name of the material asset in the plugin content.
+	 */
+	FString GetMaterialName() const;
+
+	/**
+	 * @brief The function to load the material asset.
+	 * @return The material asset, or nullptr if it is not found.
+	 */
+	UMaterialInterface* LoadMaterial() const;
+
+	/**
+	 * @brief The function to get all materials that drawables can use.
+	 * @return The list of the 9 material permutations.
+	 */
+	static TArray<FCubismMaterialPermutation> GetAll();
+
+	bool operator==(const FCubismMaterialPermutation& Other) const
+	{
+		return BlendMode == Other.BlendMode && bMasked == Other.bMasked && bInvertedMask == Other.bInvertedMask;
+	}
+};
+
+/**
+ * A class to warm up the materials of the drawables before they are drawn for the first time.
+ */
+class LIVE2DCUBISMFRAMEWORK_API FCubismMaterialPrecache
+{
+public:
+	/**
+	 * @brief The function to load the materials and precache their pipeline states with the vertex factory of the drawables.
+	 * @param Permutations The materials to precache.
+	 * @note The pipeline states are only precached on the engine versions that support the PSO precaching of materials.
+	 */
+	static void Precache(const TArray<FCubismMaterialPermutation>& Permutations);
+
+	/**
+	 * @brief The function to precache all materials that drawables can use.
+	 */
+	static void PrecacheAll();
+
+	/**
+	 * @brief The function to release the precached materials.
+	 */
+	static void Release();
+};
@@ -0,0 +1,97 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Components/MeshComponent.h"
+
+#include "CubismModelMeshComponent.generated.h"
+
+class UCubismModelComponent;
+
+/**
+ * A component to render all drawables of a Live2D Cubism model as a single primitive.
+ * The drawables are emitted in the render order of the model, and their mesh ids keep the order in the translucency sort.
+ */
+UCLASS()
+class LIVE2DCUBISMFRAMEWORK_API UCubismModelMeshComponent : public UMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief The function to set up the component.
+	 * @param InModel The model component that the component depends on.
+	 * @note This function should be called after the component is attached to the model component.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	void Setup(UCubismModelComponent* InModel);
+
+	/**
+	 * @brief The function to send the state of a drawable to the rendering thread in the next update.
+	 * @param DrawableIndex The index of the drawable.
+	 * @param bVertexPositions The flag to send the vertex positions of the drawable as well.
+	 */
+	void MarkDrawableDirty(const int32 DrawableIndex, const bool bVertexPositions);
+
+private:
+	/**
+	 * @brief The constructor of the component.
+	 */
+	UCubismModelMeshComponent();
+
+	/**
+	 * The model component that the component depends on.
+	 */
+	TObjectPtr<UCubismModelComponent> Model;
+
+	/**
+	 * The flags of the drawables to send in the next update, indexed by the drawable index.
+	 */
+	TBitArray<> DirtyDrawables;
+
+	/**
+	 * The flags of the drawables to send with their vertex positions in the next update, indexed by the drawable index.
+	 */
+	TBitArray<> DirtyVertexPositions;
+
+	/**
+	 * The flag to send all drawables with their indices and UVs in the next update, set when the proxy is created.
+	 */
+	bool bTopologyDirty;
+
+public:
+	//Begin USceneComponent Interface
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	//End USceneComponent Interface
+
+	//Begin UMeshComponent Interface
+	virtual int32 GetNumMaterials() const override;
+	virtual UMaterialInterface* GetMaterial(int32 ElementIndex) const override;
+	virtual void GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials = false) const override;
+	//End UMeshComponent Interface
+
+private:
+	// UObject interface
+	virtual void PostLoad() override;
+	// End of UObject interface
+
+	// UActorComponent interface
+	virtual void OnComponentCreated() override;
+	// End of UActorComponent interface
+
+	//Begin UPrimitiveComponent Interface
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
+	virtual void CollectPSOPrecacheData(const FPSOPrecacheParams& BasePrecachePSOParams, FMaterialInterfacePSOPrecacheParamsList& OutParams) override;
+#endif
+	//End UPrimitiveComponent Interface
+
+	virtual void CreateRenderState_Concurrent(FRegisterComponentContext* Context) override;
+	virtual void SendRenderDynamicData_Concurrent() override;
+};
@@ -13,7 +13,9 @@
 class ACubismModel;
 class ACubismMaskTexture;
 class FCubismMaskJunction;
+class UCubismDrawableComponent;
 class UCubismModelComponent;
+class UCubismModelMeshComponent;
 
 /**
  * The render order mode of the model.
@@ -46,10 +48,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
 	ECubismRendererSortingOrder SortingOrder = ECubismRendererSortingOrder::FrontToBack;
 
+	/**
+	 * The flag to render all drawables of the model as a single primitive.
+	 * The drawables are sorted by the render order of the model on the rendering thread and share the render order of the model as the translucency sort priority.
+	 * The model mesh that renders them is only created while the flag is set.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetBatchDrawables, Category = "Live2D Cubism")
+	bool bBatchDrawables = false;
+
 	/**
 	 * The flag to enable the Z-sorting of the model.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism", meta = (EditCondition = "!bBatchDrawables"))
 	bool bZSort = false;
 
 	/**
@@ -61,7 +71,7 @@ public:
 	/**
 	 * The epsilon value used for the Z-sorting of the model.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism", meta = (EditCondition = "bZSort"))
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism", meta = (EditCondition = "bZSort && !bBatchDrawables"))
 	float Epsilon = 0.1f;
 
 	/**
@@ -70,6 +80,12 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
 	int32 NumMasks;
 
+	/**
+	 * The component to render all drawables of the model as a single primitive.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	TObjectPtr<UCubismModelMeshComponent> ModelMesh;
+
 	/**
 	 * The table that associates each Drawable with the mask it uses.
 	 */
@@ -84,12 +100,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	void Setup(UCubismModelComponent* InModel);
 
+	/**
+	 * @brief The function to switch between rendering the drawables as a single primitive and rendering them separately.
+	 * @param bInBatchDrawables The flag to render all drawables of the model as a single primitive.
+	 */
+	UFUNCTION(BlueprintSetter)
+	void SetBatchDrawables(const bool bInBatchDrawables);
+
 	/**
 	 * @brief The function to apply the render order to the drawables.
+	 * @note The model mesh is created or destroyed according to `bBatchDrawables`.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
 	void ApplyRenderOrder();
 
+	/**
+	 * @brief The function to calculate the render order of the drawable in the model according to the sorting order.
+	 * @param Drawable The drawable to calculate the render order of.
+	 * @return The render order of the drawable without the render order of the model.
+	 */
+	int32 CalcDrawableRenderOrder(const UCubismDrawableComponent* Drawable) const;
+
 private:
 	/**
 	 * @brief The constructor of the component.
@@ -101,6 +132,16 @@ private:
 	 */
 	TObjectPtr<UCubismModelComponent> Model;
 
+	/**
+	 * @brief The function to create the model mesh if it does not exist.
+	 */
+	void CreateModelMesh();
+
+	/**
+	 * @brief The function to destroy the model mesh if it exists.
+	 */
+	void DestroyModelMesh();
+
 public:	
 	// UObject interface
 	virtual void PostLoad() override;
@@ -112,6 +153,7 @@ public:
 
 	// UActorComponent interface
 	virtual void OnComponentCreated() override;
+	virtual void OnRegister() override;
 	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
 
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
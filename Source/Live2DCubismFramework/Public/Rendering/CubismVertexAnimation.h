@@ -0,0 +1,234 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Model/CubismModelComponent.h"
+
+#include "CubismVertexAnimation.generated.h"
+
+class UTexture2D;
+
+/**
+ * A structure to hold the static data of a drawable baked into a vertex animation.
+ */
+USTRUCT(BlueprintType)
+struct LIVE2DCUBISMFRAMEWORK_API FCubismVertexAnimationDrawable
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * The ID of the drawable.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	FString Id;
+
+	/**
+	 * The blend mode of the drawable.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	ECubismDrawableBlendMode BlendMode = ECubismDrawableBlendMode::Normal;
+
+	/**
+	 * The flag to specify whether the drawable is masked in the model.
+	 * The masks are not baked, so the drawable is hidden unless the playback opts in to render it without them.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	bool bMasked = false;
+
+	/**
+	 * The flag to specify whether the drawable is double-sided.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	bool bTwoSided = false;
+
+	/**
+	 * The texture of the drawable.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	TObjectPtr<UTexture2D> Texture;
+
+	/**
+	 * The multiply color of the drawable.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	FLinearColor MultiplyColor = FLinearColor::White;
+
+	/**
+	 * The screen color of the drawable.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	FLinearColor ScreenColor = FLinearColor::Black;
+
+	/**
+	 * The vertex indices of the drawable.
+	 */
+	UPROPERTY()
+	TArray<int32> VertexIndices;
+
+	/**
+	 * The UVs of the vertices of the drawable.
+	 */
+	UPROPERTY()
+	TArray<FVector2f> VertexUvs;
+
+	/**
+	 * The index of the first vertex of the drawable in a frame.
+	 */
+	UPROPERTY()
+	int32 BaseVertexIndex = 0;
+
+	/**
+	 * The number of the vertices of the drawable.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	int32 VertexCount = 0;
+
+	/**
+	 * The minimum position of the vertices over all frames, on the y-z plane of the component.
+	 */
+	UPROPERTY()
+	FVector2f PositionMinimum = FVector2f::ZeroVector;
+
+	/**
+	 * The position of a step of the quantized positions, on the y-z plane of the component.
+	 */
+	UPROPERTY()
+	FVector2f PositionStep = FVector2f::ZeroVector;
+};
+
+/**
+ * An asset to hold the vertices of all drawables of a model sampled from a motion.
+ * The frames are played back by UCubismVertexAnimationComponent without a Cubism model.
+ */
+UCLASS(BlueprintType)
+class LIVE2DCUBISMFRAMEWORK_API UCubismVertexAnimation : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * The frame rate at which the motion is sampled.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	float Fps = 30.0f;
+
+	/**
+	 * The number of the frames.
+	 * The last frame is sampled at the end of the motion.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	int32 FrameCount = 0;
+
+	/**
+	 * The duration of the animation. (seconds)
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	float Duration = 0.0f;
+
+	/**
+	 * The flag to specify whether the baked motion loops.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	bool bLoop = true;
+
+	/**
+	 * The drawables of the model.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	TArray<FCubismVertexAnimationDrawable> Drawables;
+
+	/**
+	 * The number of the vertices of all drawables in a frame.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	int32 TotalVertexCount = 0;
+
+	/**
+	 * The positions of the vertices in steps from the minimum positions of the drawables, frame by frame in the order of the vertices, y before z.
+	 */
+	UPROPERTY()
+	TArray<uint16> QuantizedPositions;
+
+	/**
+	 * The opacities of the drawables including the opacity of the model, frame by frame in the order of the drawables.
+	 * Zero if the drawable is invisible.
+	 */
+	UPROPERTY()
+	TArray<uint8> Opacities;
+
+	/**
+	 * The render orders of the drawables, frame by frame in the order of the drawables.
+	 */
+	UPROPERTY()
+	TArray<int16> RenderOrders;
+
+	/**
+	 * The byte size of the frames if they were stored without compression.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	int32 UncompressedSize = 0;
+
+	/**
+	 * The byte size of the compressed frames.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	int32 CompressedSize = 0;
+
+	/**
+	 * The maximum distance between the baked and the compressed positions of the vertices.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Compression")
+	float MaxError = 0.0f;
+
+	/**
+	 * @brief The function to get the position of a vertex in a frame.
+	 * @param FrameIndex The index of the frame.
+	 * @param DrawableIndex The index of the drawable.
+	 * @param VertexIndex The index of the vertex in the drawable.
+	 * @return The position of the vertex in the component space.
+	 */
+	FVector3f GetVertexPosition(const int32 FrameIndex, const int32 DrawableIndex, const int32 VertexIndex) const;
+
+	/**
+	 * @brief The function to get the opacity of a drawable in a frame.
+	 * @param FrameIndex The index of the frame.
+	 * @param DrawableIndex The index of the drawable.
+	 * @return The opacity of the drawable, or zero if it is invisible.
+	 */
+	float GetOpacity(const int32 FrameIndex, const int32 DrawableIndex) const
+	{
+		return Opacities[FrameIndex * Drawables.Num() + DrawableIndex] / 255.0f;
+	}
+
+	/**
+	 * @brief The function to get the render order of a drawable in a frame.
+	 * @param FrameIndex The index of the frame.
+	 * @param DrawableIndex The index of the drawable.
+	 * @return The render order of the drawable.
+	 */
+	int32 GetRenderOrder(const int32 FrameIndex, const int32 DrawableIndex) const
+	{
+		return RenderOrders[FrameIndex * Drawables.Num() + DrawableIndex];
+	}
+
+	/**
+	 * @brief The function to get the frames around a time.
+	 * @param Time The time in the animation. (seconds)
+	 * @param OutFrameIndex The index of the frame at or before the time.
+	 * @param OutNextFrameIndex The index of the frame after the time.
+	 * @param OutAlpha The weight of the next frame.
+	 */
+	void FindFrames(const float Time, int32& OutFrameIndex, int32& OutNextFrameIndex, float& OutAlpha) const;
+
+	/**
+	 * @brief The function to get the bounds of all frames.
+	 * @return The box containing the vertices of all drawables in all frames, in the component space.
+	 */
+	FBox GetBounds() const;
+};
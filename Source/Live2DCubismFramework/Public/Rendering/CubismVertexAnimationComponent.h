@@ -0,0 +1,136 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Components/MeshComponent.h"
+
+#include "CubismVertexAnimationComponent.generated.h"
+
+class UCubismVertexAnimation;
+class UMaterialInstanceDynamic;
+
+/**
+ * A component to play back a vertex animation baked from a motion of a Live2D Cubism model.
+ * No Cubism model is needed, so a crowd of characters looping fixed motions costs only the decoding of the frames.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class LIVE2DCUBISMFRAMEWORK_API UCubismVertexAnimationComponent : public UMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * The vertex animation to play back.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Live2D Cubism")
+	TObjectPtr<UCubismVertexAnimation> Animation;
+
+	/**
+	 * The speed of the playback.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	float PlayRate = 1.0f;
+
+	/**
+	 * The flag to specify whether the animation loops.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	bool bLoop = true;
+
+	/**
+	 * The current time in the animation. (seconds)
+	 * Offset it per instance to keep a crowd out of sync.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Live2D Cubism")
+	float Time = 0.0f;
+
+	/**
+	 * The flag to render the masked drawables without their masks.
+	 * The masks are not baked, so the masked drawables are hidden by default rather than drawn unclipped.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetRenderMaskedDrawables, Category = "Live2D Cubism")
+	bool bRenderMaskedDrawables = false;
+
+	/**
+	 * @brief The function to replace the vertex animation.
+	 * @param InAnimation The vertex animation to play back.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	void SetAnimation(UCubismVertexAnimation* InAnimation);
+
+	/**
+	 * @brief The function to switch whether the masked drawables are rendered without their masks.
+	 * @param bInRenderMaskedDrawables The flag to render the masked drawables without their masks.
+	 */
+	UFUNCTION(BlueprintSetter)
+	void SetRenderMaskedDrawables(const bool bInRenderMaskedDrawables);
+
+private:
+	/**
+	 * @brief The constructor of the component.
+	 */
+	UCubismVertexAnimationComponent();
+
+	/**
+	 * @brief The function to create the material instances of the drawables of the animation.
+	 */
+	void CreateMaterialInstances();
+
+	/**
+	 * @brief The function to update the opacities of the drawables at the current time.
+	 */
+	void UpdateOpacities();
+
+	/**
+	 * The material instances of the drawables.
+	 */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMaterialInstanceDynamic>> MaterialInstances;
+
+	/**
+	 * The opacities of the drawables at the current time.
+	 */
+	TArray<float> Opacities;
+
+	/**
+	 * The flag to send the indices and the UVs with the next vertices, set when the proxy is created.
+	 */
+	bool bTopologyDirty;
+
+public:
+	//Begin USceneComponent Interface
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	//End USceneComponent Interface
+
+	//Begin UMeshComponent Interface
+	virtual int32 GetNumMaterials() const override;
+	virtual UMaterialInterface* GetMaterial(int32 ElementIndex) const override;
+	virtual void GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials = false) const override;
+	//End UMeshComponent Interface
+
+private:
+#if WITH_EDITORONLY_DATA
+	// UObject interface
+	void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	// End of UObject interface
+#endif
+
+	// UActorComponent interface
+	virtual void OnRegister() override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// End of UActorComponent interface
+
+	//Begin UPrimitiveComponent Interface
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	//End UPrimitiveComponent Interface
+
+	virtual void CreateRenderState_Concurrent(FRegisterComponentContext* Context) override;
+	virtual void SendRenderDynamicData_Concurrent() override;
+};
@@ -79,9 +79,19 @@ void UCubismModelActorFactory::CreateModel(const TObjectPtr<ACubismModel>& Model
 		UCubismMotionComponent* Motion = NewObject<UCubismMotionComponent>(Model, TEXT("CubismMotion"), RF_Transactional);
 
 		Motion->Jsons.Empty();
+		Motion->Groups.Empty();
 		for (const FMotion3JsonGroup& Group : Motion3JsonGroups)
 		{
-			Motion->Jsons.Append(Group.Motion3Jsons);
+			FCubismMotionGroup MotionGroup;
+
+			MotionGroup.Name = FName(*Group.Name);
+
+			for (const TObjectPtr<UCubismMotion3Json>& Json : Group.Motion3Jsons)
+			{
+				MotionGroup.Indices.Add(Motion->Jsons.Add(Json));
+			}
+
+			Motion->Groups.Add(MotionGroup);
 		}
 
 		Motion->RegisterComponent();
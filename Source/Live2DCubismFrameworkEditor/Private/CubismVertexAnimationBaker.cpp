@@ -0,0 +1,288 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#include "CubismVertexAnimationBaker.h"
+
+#include "Model/CubismDrawableComponent.h"
+#include "Model/CubismModelComponent.h"
+#include "Model/CubismParameterComponent.h"
+#include "Motion/CubismMotionData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "CubismLog.h"
+
+UCubismVertexAnimation* UCubismVertexAnimationBaker::BakeVertexAnimation(ACubismModel* ModelActor, UCubismMotion3Json* Motion, float Fps)
+{
+	if (!ModelActor || !ModelActor->Model || !Motion)
+	{
+		UE_LOG(LogCubism, Warning, TEXT("BakeVertexAnimation: The model or the motion is not specified."));
+		return nullptr;
+	}
+
+	if (Motion->Duration <= 0.0f || Fps <= 0.0f)
+	{
+		UE_LOG(LogCubism, Warning, TEXT("BakeVertexAnimation: %s has no duration to bake."), *Motion->GetName());
+		return nullptr;
+	}
+
+	UCubismModelComponent* Model = ModelActor->Model;
+
+	const TSharedPtr<const FCubismMotionData> Data = Motion->GetMotionData();
+
+	// sample the both ends of the motion, so that the loop closes on the first frame
+	const int32 FrameCount = FMath::Max(FMath::CeilToInt32(Motion->Duration * Fps), 1) + 1;
+	const float FrameTime = Motion->Duration / (FrameCount - 1);
+
+	TArray<UCubismParameterComponent*> Parameters;
+	Parameters.Reserve(Data->Curves.Num());
+
+	// the parameters are looked up without registering the unknown IDs, which can not move the drawables anyway
+	for (const FCubismMotionCurve& Curve : Data->Curves)
+	{
+		const int32* ParameterIndex = Curve.Target == ECubismMotionCurveTarget::Model? nullptr : Model->ParameterIndices.Find(Curve.Id);
+
+		Parameters.Add(ParameterIndex? Model->GetParameter(*ParameterIndex) : nullptr);
+	}
+
+	// keep the state of the model to restore it after the bake
+	TArray<float> SavedValues;
+	SavedValues.Reserve(Model->Parameters.Num());
+
+	for (const TObjectPtr<UCubismParameterComponent>& Parameter : Model->Parameters)
+	{
+		SavedValues.Add(Parameter->GetParameterValue());
+	}
+
+	const float SavedOpacity = Model->Opacity;
+
+	const int32 DrawableCount = Model->GetDrawableCount();
+	const float Scale = 0.01f * Model->GetPixelsPerUnit();
+
+	TArray<FCubismVertexAnimationDrawable> Drawables;
+	Drawables.SetNum(DrawableCount);
+
+	int32 TotalVertexCount = 0;
+	int32 MaskedCount = 0;
+
+	for (const TObjectPtr<UCubismDrawableComponent>& DrawableComponent : Model->Drawables)
+	{
+		FCubismVertexAnimationDrawable& Drawable = Drawables[DrawableComponent->Index];
+
+		Drawable.Id = DrawableComponent->Id;
+		Drawable.BlendMode = DrawableComponent->BlendMode;
+		Drawable.bMasked = DrawableComponent->IsMasked();
+		Drawable.bTwoSided = DrawableComponent->bTwoSided;
+		Drawable.Texture = Model->Textures.IsValidIndex(DrawableComponent->TextureIndex)? Model->Textures[DrawableComponent->TextureIndex] : nullptr;
+		Drawable.MultiplyColor = DrawableComponent->MultiplyColor;
+		Drawable.ScreenColor = DrawableComponent->ScreenColor;
+		Drawable.VertexIndices = DrawableComponent->GetVertexIndices();
+
+		for (const FVector2D& Uv : DrawableComponent->GetVertexUvs())
+		{
+			Drawable.VertexUvs.Add(FVector2f(Uv));
+		}
+
+		Drawable.BaseVertexIndex = TotalVertexCount;
+		Drawable.VertexCount = Model->GetDrawableVertexCount(DrawableComponent->Index);
+
+		TotalVertexCount += Drawable.VertexCount;
+
+		if (Drawable.bMasked)
+		{
+			MaskedCount++;
+		}
+	}
+
+	if (MaskedCount > 0)
+	{
+		UE_LOG(LogCubism, Warning, TEXT("BakeVertexAnimation: The masks are not baked. %d masked drawables of %s are hidden in the playback unless bRenderMaskedDrawables is set."), MaskedCount, *ModelActor->GetName());
+	}
+
+	// sample the drawables frame by frame
+	TArray<FVector2f> Positions;
+	Positions.SetNumUninitialized(FrameCount * TotalVertexCount);
+
+	TArray<uint8> Opacities;
+	Opacities.SetNumUninitialized(FrameCount * DrawableCount);
+
+	TArray<int16> RenderOrders;
+	RenderOrders.SetNumUninitialized(FrameCount * DrawableCount);
+
+	TArray<int32> Cursors;
+	TArray<float> Values;
+
+	for (int32 FrameIndex = 0; FrameIndex < FrameCount; FrameIndex++)
+	{
+		ApplyMotion(Model, *Data, Parameters, FrameIndex * FrameTime, Cursors, Values);
+
+		for (int32 DrawableIndex = 0; DrawableIndex < DrawableCount; DrawableIndex++)
+		{
+			const FCubismVertexAnimationDrawable& Drawable = Drawables[DrawableIndex];
+
+			const float Opacity = Model->GetDrawableDynamicFlagIsVisible(DrawableIndex)? Model->Opacity * Model->GetDrawableOpacity(DrawableIndex) : 0.0f;
+
+			Opacities[FrameIndex * DrawableCount + DrawableIndex] = (uint8)FMath::RoundToInt32(255.0f * FMath::Clamp(Opacity, 0.0f, 1.0f));
+			RenderOrders[FrameIndex * DrawableCount + DrawableIndex] = (int16)Model->GetDrawableRenderOrder(DrawableIndex);
+
+			const csmVector2* VertexPositions = Model->GetDrawableVertexPosition(DrawableIndex);
+			FVector2f* FramePositions = &Positions[FrameIndex * TotalVertexCount + Drawable.BaseVertexIndex];
+
+			// align the model on the y-z plane
+			for (int32 VertexIndex = 0; VertexIndex < Drawable.VertexCount; VertexIndex++)
+			{
+				FramePositions[VertexIndex] = FVector2f(-Scale * VertexPositions[VertexIndex].X, Scale * VertexPositions[VertexIndex].Y);
+			}
+		}
+	}
+
+	// restore the model
+	for (int32 ParameterIndex = 0; ParameterIndex < SavedValues.Num(); ParameterIndex++)
+	{
+		Model->Parameters[ParameterIndex]->SetParameterValue(SavedValues[ParameterIndex]);
+	}
+
+	Model->Opacity = SavedOpacity;
+	Model->UpdateModel();
+
+	// quantize the positions of each drawable in its own range
+	TArray<uint16> QuantizedPositions;
+	QuantizedPositions.SetNumUninitialized(2 * Positions.Num());
+
+	float MaxError = 0.0f;
+
+	for (FCubismVertexAnimationDrawable& Drawable : Drawables)
+	{
+		if (Drawable.VertexCount == 0)
+		{
+			continue;
+		}
+
+		FVector2f Minimum(MAX_flt, MAX_flt);
+		FVector2f Maximum(-MAX_flt, -MAX_flt);
+
+		for (int32 FrameIndex = 0; FrameIndex < FrameCount; FrameIndex++)
+		{
+			for (int32 VertexIndex = 0; VertexIndex < Drawable.VertexCount; VertexIndex++)
+			{
+				const FVector2f& Position = Positions[FrameIndex * TotalVertexCount + Drawable.BaseVertexIndex + VertexIndex];
+
+				Minimum = FVector2f::Min(Minimum, Position);
+				Maximum = FVector2f::Max(Maximum, Position);
+			}
+		}
+
+		Drawable.PositionMinimum = Minimum;
+		Drawable.PositionStep = (Maximum - Minimum) / (float)MAX_uint16;
+
+		for (int32 FrameIndex = 0; FrameIndex < FrameCount; FrameIndex++)
+		{
+			for (int32 VertexIndex = 0; VertexIndex < Drawable.VertexCount; VertexIndex++)
+			{
+				const int32 PositionIndex = FrameIndex * TotalVertexCount + Drawable.BaseVertexIndex + VertexIndex;
+				const FVector2f& Position = Positions[PositionIndex];
+
+				FVector2f Decoded;
+
+				for (int32 Axis = 0; Axis < 2; Axis++)
+				{
+					const float Step = Drawable.PositionStep[Axis];
+					const uint16 Quantized = Step > 0.0f? (uint16)FMath::Clamp(FMath::RoundToInt32((Position[Axis] - Minimum[Axis]) / Step), 0, (int32)MAX_uint16) : 0;
+
+					QuantizedPositions[2 * PositionIndex + Axis] = Quantized;
+					Decoded[Axis] = Minimum[Axis] + Step * Quantized;
+				}
+
+				MaxError = FMath::Max(MaxError, FVector2f::Distance(Decoded, Position));
+			}
+		}
+	}
+
+	// save the asset next to the json asset
+	const FString PackageName = FPackageName::GetLongPackagePath(Motion->GetOutermost()->GetPathName()) / (Motion->GetName() + TEXT("_VertexAnimation"));
+	const FString AssetName = FPackageName::GetShortName(PackageName);
+
+	UPackage* Package = CreatePackage(*PackageName);
+
+	UCubismVertexAnimation* Animation = FindObject<UCubismVertexAnimation>(Package, *AssetName);
+
+	if (!Animation)
+	{
+		Animation = NewObject<UCubismVertexAnimation>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+
+		FAssetRegistryModule::AssetCreated(Animation);
+	}
+
+	Animation->Modify();
+
+	Animation->Fps = 1.0f / FrameTime;
+	Animation->FrameCount = FrameCount;
+	Animation->Duration = Motion->Duration;
+	Animation->bLoop = Motion->bLoop;
+	Animation->Drawables = MoveTemp(Drawables);
+	Animation->TotalVertexCount = TotalVertexCount;
+	Animation->QuantizedPositions = MoveTemp(QuantizedPositions);
+	Animation->Opacities = MoveTemp(Opacities);
+	Animation->RenderOrders = MoveTemp(RenderOrders);
+
+	// the frames would be played back as the vertex positions, opacities and render orders the renderer consumes
+	Animation->UncompressedSize = FrameCount * (TotalVertexCount * (int32)sizeof(FVector3f) + DrawableCount * (int32)(sizeof(float) + sizeof(int32)));
+	Animation->CompressedSize = Animation->QuantizedPositions.Num() * (int32)sizeof(uint16) + Animation->Opacities.Num() * (int32)sizeof(uint8) + Animation->RenderOrders.Num() * (int32)sizeof(int16);
+	Animation->MaxError = MaxError;
+
+	Package->MarkPackageDirty();
+
+	UE_LOG(
+		LogCubism,
+		Log,
+		TEXT("%s: Baked %d frames of %d vertices into %d bytes from %d bytes (%.1f%%), max error %f."),
+		*AssetName,
+		FrameCount,
+		TotalVertexCount,
+		Animation->CompressedSize,
+		Animation->UncompressedSize,
+		Animation->UncompressedSize > 0? 100.0f * Animation->CompressedSize / Animation->UncompressedSize : 0.0f,
+		MaxError
+	);
+
+	return Animation;
+}
+
+void UCubismVertexAnimationBaker::ApplyMotion(UCubismModelComponent* Model, const FCubismMotionData& Data, const TArray<UCubismParameterComponent*>& Parameters, const float Time, TArray<int32>& Cursors, TArray<float>& Values)
+{
+	if (Cursors.Num() != Data.Curves.Num())
+	{
+		Cursors.Init(INDEX_NONE, Data.Curves.Num());
+	}
+
+	Data.EvaluateAll(Time, Cursors, Values);
+
+	for (const int32 CurveIndex : Data.ModelCurveIndices)
+	{
+		if (Data.Curves[CurveIndex].ModelCurve == ECubismMotionModelCurve::Opacity)
+		{
+			Model->Opacity = Values[CurveIndex];
+		}
+	}
+
+	for (const int32 CurveIndex : Data.ParameterCurveIndices)
+	{
+		if (UCubismParameterComponent* Parameter = Parameters[CurveIndex])
+		{
+			Parameter->SetParameterValue(Values[CurveIndex]);
+		}
+	}
+
+	for (const int32 CurveIndex : Data.PartOpacityCurveIndices)
+	{
+		if (UCubismParameterComponent* Parameter = Parameters[CurveIndex])
+		{
+			Parameter->SetParameterValue(Values[CurveIndex]);
+		}
+	}
+
+	Model->UpdateModel();
+}
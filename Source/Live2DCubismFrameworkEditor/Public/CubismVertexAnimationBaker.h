@@ -0,0 +1,49 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+
+#pragma once
+
+#include "Model/CubismModelActor.h"
+#include "Motion/CubismMotion3Json.h"
+#include "Rendering/CubismVertexAnimation.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "CubismVertexAnimationBaker.generated.h"
+
+/**
+ * A class to bake the motions of Live2D Cubism models into vertex animations.
+ */
+UCLASS()
+class UCubismVertexAnimationBaker : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief The function to sample the drawables of a model playing a motion and save them as a vertex animation asset.
+	 * @param ModelActor The model actor to play the motion.
+	 * @param Motion The json asset that contains the motion information.
+	 * @param Fps The frame rate at which the motion is sampled.
+	 * @return The vertex animation asset saved next to the json asset, or nullptr if the motion can not be baked.
+	 * @note Only the curves of the motion are applied. The physics, the pose and the other effects of the model are not baked.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Live2D Cubism")
+	static UCubismVertexAnimation* BakeVertexAnimation(ACubismModel* ModelActor, UCubismMotion3Json* Motion, float Fps = 30.0f);
+
+private:
+	/**
+	 * @brief The function to apply the curves of a motion to a model and update the model.
+	 * @param Model The model component to update.
+	 * @param Data The curves of the motion.
+	 * @param Parameters The parameters targeted by the curves, in the order of the curves.
+	 * @param Time The time in the motion. (seconds)
+	 * @param Cursors The cursors of the curves.
+	 * @param Values The buffer for the values of the curves.
+	 */
+	static void ApplyMotion(UCubismModelComponent* Model, const FCubismMotionData& Data, const TArray<UCubismParameterComponent*>& Parameters, const float Time, TArray<int32>& Cursors, TArray<float>& Values);
+};
@@ -66,5 +66,8 @@ UObject* UCubismMoc3Factory::FactoryCreateBinary
 	Result->Bytes = Bytes;
 	Result->Setup();
 
+	// report the materials to warm up for the model
+	Result->LogMaterialPermutations();
+
 	return Result;
 }
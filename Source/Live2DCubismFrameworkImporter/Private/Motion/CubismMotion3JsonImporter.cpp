@@ -52,6 +52,7 @@ bool FCubismMotion3JsonImporter::ImportFromString(const FString& FileContent)
 		(*Meta)->TryGetNumberField(TEXT("FadeInTime"), FadeInTime);
 		(*Meta)->TryGetNumberField(TEXT("FadeOutTime"), FadeOutTime);
 		ASSERT((*Meta)->TryGetBoolField(TEXT("Loop"), bLoop), "Failed to get Loop field.");
+		(*Meta)->TryGetBoolField(TEXT("AreBeziersRestricted"), bAreBeziersRestricted);
 	}
 
 	const TArray< TSharedPtr<FJsonValue> >*  CurvesArrayObject;
@@ -83,11 +84,13 @@ bool FCubismMotion3JsonImporter::ImportFromString(const FString& FileContent)
 				ensure(false);
 			}
 			ASSERT(CurveObject->TryGetStringField(TEXT("Id"), Curve.Id), "Failed to get Id field.");
+			if (Curve.Target == ECubismMotionCurveTarget::Model)
+			{
+				Curve.ModelCurve = FCubismMotionCurve::ClassifyModelCurve(Curve.Id);
+			}
 			CurveObject->TryGetNumberField(TEXT("FadeInTime"), Curve.FadeInTime);
 			CurveObject->TryGetNumberField(TEXT("FadeOutTime"), Curve.FadeOutTime);
 
-			Curves.Add(Curve);
-
 			const TArray<TSharedPtr<FJsonValue>>* SegmentsArrayObject;
 			ASSERT(CurveObject->TryGetArrayField(TEXT("Segments"), SegmentsArrayObject), "Failed to get Segments field.");
 			{
@@ -98,9 +101,14 @@ bool FCubismMotion3JsonImporter::ImportFromString(const FString& FileContent)
 					Segments.Add(SegmentValue->AsNumber());
 				}
 
+				ASSERT(Segments.Num() >= 2, "Failed to get the first point of Segments field.");
+
+				AppendSegments(Curve, Segments);
+
 				MotionCurves.Add(*Curve.Id, Segments);
 			}
 
+			Curves.Add(Curve);
 		}
 	}
 
@@ -114,7 +122,12 @@ void FCubismMotion3JsonImporter::ApplyParams(EObjectFlags Flags, const TObjectPt
 	Json->Fps = Fps;
 	Json->FadeInTime = FadeInTime;
 	Json->FadeOutTime = FadeOutTime;
+	Json->bAreBeziersRestricted = bAreBeziersRestricted;
 	Json->Curves.Append(Curves);
+	Json->SegmentTypes = SegmentTypes;
+	Json->SegmentBasePointIndices = SegmentBasePointIndices;
+	Json->PointTimes = PointTimes;
+	Json->PointValues = PointValues;
 	
 	UCurveTable* CurveTable = NewObject<UCurveTable>(Json, TEXT("CurveTable"), Flags);
 	
@@ -237,3 +250,71 @@ TArray<FRichCurveKey> FCubismMotion3JsonImporter::ParseSegments(const TArray<flo
 
 	return KeyFrames;
 }
+
+void FCubismMotion3JsonImporter::AppendSegments(FCubismMotionCurve& Curve, const TArray<float>& Segments)
+{
+	Curve.BaseSegmentIndex = SegmentTypes.Num();
+	Curve.SegmentCount = 0;
+
+	// the segments share their end points with the next segments
+	PointTimes.Add(Segments[0]);
+	PointValues.Add(Segments[1]);
+
+	int32 i = 2;
+	while (i < Segments.Num())
+	{
+		const int32 SegmentType = Segments[i];
+
+		int32 PointCount;
+		switch (SegmentType)
+		{
+			case 0: // Linear
+			case 2: // Stepped
+			case 3: // InverseStepped
+			{
+				PointCount = 1;
+				break;
+			}
+			case 1: // 3rd order Bezier
+			{
+				PointCount = 3;
+				break;
+			}
+			default:
+			{
+				ensure(false);
+				return;
+			}
+		}
+
+		if (!ensure(i + 2 * PointCount < Segments.Num()))
+		{
+			return;
+		}
+
+		SegmentTypes.Add(static_cast<ECubismMotionSegmentType>(SegmentType));
+		SegmentBasePointIndices.Add(PointTimes.Num() - 1);
+
+		for (int32 Point = 0; Point < PointCount; Point++)
+		{
+			PointTimes.Add(Segments[i + 1 + 2 * Point]);
+			PointValues.Add(Segments[i + 2 + 2 * Point]);
+		}
+
+		Curve.SegmentCount++;
+
+		i += 1 + 2 * PointCount;
+	}
+
+	// a curve with only the first point holds its value
+	if (Curve.SegmentCount == 0)
+	{
+		SegmentTypes.Add(ECubismMotionSegmentType::Stepped);
+		SegmentBasePointIndices.Add(PointTimes.Num() - 1);
+
+		PointTimes.Add(Segments[0]);
+		PointValues.Add(Segments[1]);
+
+		Curve.SegmentCount++;
+	}
+}
@@ -25,6 +25,8 @@ private:
 
 	TArray<FRichCurveKey> ParseSegments(const TArray<float>& Segments) const;
 
+	void AppendSegments(FCubismMotionCurve& Curve, const TArray<float>& Segments);
+
 protected:
 	int32 Version;
 
@@ -38,9 +40,19 @@ protected:
 
 	float FadeOutTime = 1.0f;
 
+	bool bAreBeziersRestricted = false;
+
 	TArray<FCubismMotionCurve> Curves;
 
 	TMap<FName, TArray<float>> MotionCurves;
 
 	TArray<FCubismMotionEvent> Events;
+
+	TArray<ECubismMotionSegmentType> SegmentTypes;
+
+	TArray<int32> SegmentBasePointIndices;
+
+	TArray<float> PointTimes;
+
+	TArray<float> PointValues;
 };